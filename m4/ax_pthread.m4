@@ -0,0 +1,101 @@
+# ============================================================================
+#  ax_pthread.m4
+# ============================================================================
+#
+# SYNOPSIS
+#
+#   AX_PTHREAD([ACTION-IF-FOUND[, ACTION-IF-NOT-FOUND]])
+#
+# DESCRIPTION
+#
+#   Find the flags needed to compile and link programs that use POSIX
+#   threads, and substitute them as PTHREAD_CFLAGS and PTHREAD_LIBS.
+#   Programs must be compiled with $PTHREAD_CFLAGS and linked with
+#   $PTHREAD_CFLAGS $PTHREAD_LIBS.
+#
+#   This is a reduced version of the macro of the same name in the
+#   Autoconf Archive, with the same interface for the flags. It only
+#   tries the flags of the compilers MathView is built with: none
+#   (threads are part of libc), -pthread (GCC, Clang), -pthreads,
+#   -mt, and -lpthread. It does not set PTHREAD_CC.
+#
+#   Flags already given in PTHREAD_CFLAGS and PTHREAD_LIBS are tried
+#   first.
+#
+# LICENSE
+#
+#   Copying and distribution of this file, with or without modification,
+#   are permitted in any medium without royalty provided the copyright
+#   notice and this notice are preserved.  This file is offered as-is,
+#   without any warranty.
+
+#serial 1
+
+AC_DEFUN([AX_PTHREAD], [
+AC_LANG_PUSH([C])
+ax_pthread_ok=no
+
+# GCC and Clang accept the other flags too but need -pthread to define
+# _REENTRANT, so it must be tried before "none"
+ax_pthread_flags="none -pthreads -mt pthread"
+if test "x$GCC" = "xyes"; then
+  ax_pthread_flags="-pthread $ax_pthread_flags"
+fi
+if test "x$PTHREAD_CFLAGS$PTHREAD_LIBS" != "x"; then
+  ax_pthread_flags="given $ax_pthread_flags"
+fi
+
+for ax_pthread_try_flag in $ax_pthread_flags; do
+  case $ax_pthread_try_flag in
+    given)
+      AC_MSG_CHECKING([whether pthreads work with $PTHREAD_CFLAGS $PTHREAD_LIBS])
+      ;;
+    none)
+      PTHREAD_CFLAGS=""
+      PTHREAD_LIBS=""
+      AC_MSG_CHECKING([whether pthreads work without any flags])
+      ;;
+    -*)
+      PTHREAD_CFLAGS="$ax_pthread_try_flag"
+      PTHREAD_LIBS=""
+      AC_MSG_CHECKING([whether pthreads work with $ax_pthread_try_flag])
+      ;;
+    *)
+      PTHREAD_CFLAGS=""
+      PTHREAD_LIBS="-l$ax_pthread_try_flag"
+      AC_MSG_CHECKING([for the pthreads library -l$ax_pthread_try_flag])
+      ;;
+  esac
+
+  ax_pthread_save_CFLAGS="$CFLAGS"
+  ax_pthread_save_LIBS="$LIBS"
+  CFLAGS="$CFLAGS $PTHREAD_CFLAGS"
+  LIBS="$PTHREAD_CFLAGS $PTHREAD_LIBS $LIBS"
+  AC_LINK_IFELSE([AC_LANG_PROGRAM([[#include <pthread.h>
+static void* routine(void* a) { return a; }]],
+      [[pthread_t th;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_create(&th, &attr, routine, 0);
+        pthread_join(th, 0);
+        pthread_cleanup_push(0, 0);
+        pthread_cleanup_pop(0);]])],
+    [ax_pthread_ok=yes])
+  CFLAGS="$ax_pthread_save_CFLAGS"
+  LIBS="$ax_pthread_save_LIBS"
+
+  AC_MSG_RESULT([$ax_pthread_ok])
+  test "x$ax_pthread_ok" = "xyes" && break
+done
+
+if test "x$ax_pthread_ok" = "xno"; then
+  PTHREAD_CFLAGS=""
+  PTHREAD_LIBS=""
+fi
+
+AC_SUBST([PTHREAD_CFLAGS])
+AC_SUBST([PTHREAD_LIBS])
+AC_LANG_POP([C])
+
+AS_IF([test "x$ax_pthread_ok" = "xyes"], [$1], [$2])
+])
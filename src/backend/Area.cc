@@ -25,12 +25,21 @@
 #include <cassert>
 
 #include "Area.hh"
+#include "AreaArena.hh"
 #include "Point.hh"
 #include "Element.hh"
 #include "Rectangle.hh"
 #include "GlyphStringArea.hh"
 #include "GlyphArea.hh"
 
+void*
+Area::operator new(size_t n)
+{ return AreaArena::allocateArea(n); }
+
+void
+Area::operator delete(void* p)
+{ AreaArena::releaseArea(p); }
+
 scaled
 Area::originX(AreaIndex i) const
 {
@@ -23,6 +23,8 @@
 #ifndef __Area_hh__
 #define __Area_hh__
 
+#include <cstddef>
+
 #include "BoundingBox.hh"
 #include "Object.hh"
 #include "SmartPtr.hh"
@@ -34,11 +36,31 @@ typedef int AreaIndex;
 
 class Area : public Object
 {
+public:
+  // only the areas that are tested for by the formatting and the
+  // rendering code have a kind of their own, see KindCast.hh
+  enum Kind
+    {
+      KArea,
+      KHorizontalArrayArea,
+      KGlyphStringArea,
+      KOverlapArrayArea,
+      KVerticalArrayArea,
+      KWrapperArea,
+      KGlyphArea
+    };
+
 protected:
-  Area(void) { };
+  Area(Kind k = KArea) : kind(k) { };
   virtual ~Area() { };
 
 public:
+  Kind getKind(void) const { return kind; }
+
+  // areas are allocated in the current AreaArena of the thread, if any
+  static void* operator new(size_t);
+  static void operator delete(void*);
+
   virtual BoundingBox box(void) const = 0;
   virtual void render(class RenderingContext&, const scaled& x, const scaled& y) const = 0;
   virtual AreaRef fit(const scaled&, const scaled&, const scaled&) const = 0;
@@ -56,6 +78,9 @@ public:
 
   virtual bool searchByArea(class AreaId&, const AreaRef&) const = 0;
   virtual bool searchByCoords(class AreaId&, const scaled&, const scaled&) const = 0;
+  // registers with the index, in the same order searchByCoords would
+  // try them, the areas at which searchByCoords may stop
+  virtual void indexByCoords(class SpatialIndex&, const scaled&, const scaled&) const = 0;
   virtual bool searchByIndex(class AreaId&, CharIndex) const = 0;
   virtual AreaRef flatten(void) const { return this; }
 
@@ -66,6 +91,9 @@ public:
 
   scaled originX(AreaIndex) const;
   scaled originY(AreaIndex) const;
+
+private:
+  const Kind kind;
 };
 
 #endif // __Area_hh__
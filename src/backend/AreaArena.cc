@@ -0,0 +1,132 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <config.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <new>
+
+#include "AreaArena.hh"
+
+// Every area is preceded by a header recording the arena it was
+// allocated in, or null if it was allocated on the heap. Blocks are
+// aligned like those returned by operator new, so that areas can hold
+// members of any type
+struct alignas(std::max_align_t) AreaHeader
+{
+  AreaArena* arena;
+};
+
+static const size_t FIRST_CHUNK_SIZE = 4096;
+static const size_t MAX_CHUNK_SIZE = 64 * 1024;
+
+static thread_local AreaArena* currentArena = nullptr;
+static thread_local AreaAllocationStats stats;
+
+static const size_t ALIGNMENT = alignof(std::max_align_t);
+
+static size_t
+alignedSize(size_t n)
+{ return (n + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+AreaArena::AreaArena()
+  : next(nullptr), limit(nullptr), nextChunkSize(FIRST_CHUNK_SIZE), size(0), areaCount(0), liveAreas(0)
+{ stats.liveArenas++; }
+
+AreaArena::~AreaArena()
+{
+  stats.liveArenas--;
+  for (std::vector<char*>::const_iterator p = chunks.begin(); p != chunks.end(); p++)
+    ::operator delete(*p);
+}
+
+AreaArena::Scope::Scope(const SmartPtr<AreaArena>& a)
+  : arena(a), previous(currentArena)
+{ currentArena = arena; }
+
+AreaArena::Scope::~Scope()
+{ currentArena = previous; }
+
+AreaArena*
+AreaArena::getCurrent()
+{ return currentArena; }
+
+AreaAllocationStats
+AreaArena::getStats()
+{ return stats; }
+
+void*
+AreaArena::allocate(size_t n)
+{
+  n = alignedSize(n);
+  if (next == nullptr || static_cast<size_t>(limit - next) < n)
+    {
+      const size_t chunkSize = std::max(n, nextChunkSize);
+      next = static_cast<char*>(::operator new(chunkSize));
+      limit = next + chunkSize;
+      chunks.push_back(next);
+      if (nextChunkSize < MAX_CHUNK_SIZE) nextChunkSize *= 2;
+    }
+
+  void* p = next;
+  next += n;
+  size += n;
+  areaCount++;
+  return p;
+}
+
+void*
+AreaArena::allocateArea(size_t n)
+{
+  AreaHeader* header;
+  if (AreaArena* arena = currentArena)
+    {
+      header = static_cast<AreaHeader*>(arena->allocate(sizeof(AreaHeader) + n));
+      header->arena = arena;
+      // one reference stands for all the live areas of the arena
+      if (arena->liveAreas++ == 0) arena->ref();
+      stats.arena++;
+      stats.arenaBytes += alignedSize(sizeof(AreaHeader) + n);
+    }
+  else
+    {
+      header = static_cast<AreaHeader*>(::operator new(sizeof(AreaHeader) + n));
+      header->arena = nullptr;
+      stats.heap++;
+    }
+  return header + 1;
+}
+
+void
+AreaArena::releaseArea(void* p)
+{
+  if (!p) return;
+  AreaHeader* header = static_cast<AreaHeader*>(p) - 1;
+  if (AreaArena* arena = header->arena)
+    {
+      // the memory is reclaimed together with the whole arena
+      assert(arena->liveAreas > 0);
+      if (--arena->liveAreas == 0) arena->unref();
+    }
+  else
+    ::operator delete(header);
+}
@@ -0,0 +1,102 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __AreaArena_hh__
+#define __AreaArena_hh__
+
+#include <cstddef>
+#include <vector>
+
+#include "Object.hh"
+#include "SmartPtr.hh"
+
+// An AreaArena bump-allocates the areas created while it is the
+// current arena of the thread, typically during one formatting pass.
+// The arena counts its live areas, and while there are any it holds a
+// reference to itself, so the memory of a generation is released in
+// one go when the last of its areas is destroyed. The count is not
+// atomic: like the element tree, the areas of a view belong to one
+// thread. Since a single surviving area pins the whole generation,
+// areas meant to outlive the pass, such as those in the shaped string
+// caches and the operator areas reused by rows, must be created under
+// AreaArena::Scope(nullptr), and View only formats in an arena when
+// the whole tree is laid out again.
+
+struct AreaAllocationStats
+{
+  AreaAllocationStats(void) : heap(0), arena(0), arenaBytes(0), liveArenas(0) { }
+
+  unsigned long heap;
+  unsigned long arena;
+  unsigned long arenaBytes;
+  unsigned long liveArenas;
+};
+
+class AreaArena : public Object
+{
+protected:
+  AreaArena(void);
+  virtual ~AreaArena();
+
+public:
+  static SmartPtr<AreaArena> create(void) { return new AreaArena(); }
+
+  // installs an arena (or none, to force heap allocation) as the
+  // current arena of the calling thread for the lifetime of the scope
+  class Scope
+  {
+  public:
+    Scope(const SmartPtr<AreaArena>&);
+    ~Scope();
+
+  private:
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+
+    SmartPtr<AreaArena> arena;
+    AreaArena* previous;
+  };
+
+  static AreaArena* getCurrent(void);
+  // counts the allocations done by the calling thread and the arenas
+  // it created that are still alive
+  static AreaAllocationStats getStats(void);
+
+  unsigned getAreaCount(void) const { return areaCount; }
+  unsigned getLiveAreaCount(void) const { return liveAreas; }
+  size_t getSize(void) const { return size; }
+
+  // used by Area::operator new and Area::operator delete
+  static void* allocateArea(size_t);
+  static void releaseArea(void*);
+
+private:
+  void* allocate(size_t);
+
+  std::vector<char*> chunks;
+  char* next;
+  char* limit;
+  size_t nextChunkSize;
+  size_t size;
+  unsigned areaCount;
+  unsigned liveAreas;
+};
+
+#endif // __AreaArena_hh__
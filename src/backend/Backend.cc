@@ -51,3 +51,9 @@ SmartPtr<MathGraphicDevice>
 Backend::getMathGraphicDevice() const
 { return mathGraphicDevice; }
 
+void
+Backend::clearCache() const
+{
+  if (mathGraphicDevice)
+    mathGraphicDevice->clearCache();
+}
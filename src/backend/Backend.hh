@@ -36,6 +36,8 @@ public:
   SmartPtr<class ShaperManager> getShaperManager(void) const;
   void setMathGraphicDevice(const SmartPtr<class MathGraphicDevice>&);
   virtual SmartPtr<class MathGraphicDevice> getMathGraphicDevice(void) const;
+  // releases the shaped strings, glyphs and fonts cached by the backend
+  virtual void clearCache(void) const;
 
 private:
   SmartPtr<class ShaperManager> shaperManager;
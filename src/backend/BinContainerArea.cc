@@ -24,6 +24,7 @@
 
 #include "AreaId.hh"
 #include "BinContainerArea.hh"
+#include "SpatialIndex.hh"
 #include "GlyphStringArea.hh"
 #include "GlyphArea.hh"
 
@@ -74,6 +75,14 @@ BinContainerArea::searchByCoords(AreaId& id, const scaled& x, const scaled& y) c
   return false;
 }
 
+void
+BinContainerArea::indexByCoords(SpatialIndex& index, const scaled& x, const scaled& y) const
+{
+  index.push(0, child, scaled::zero(), scaled::zero());
+  child->indexByCoords(index, x, y);
+  index.pop();
+}
+
 bool
 BinContainerArea::searchByIndex(AreaId& id, CharIndex index) const
 {
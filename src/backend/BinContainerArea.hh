@@ -28,7 +28,7 @@
 class BinContainerArea : public ContainerArea
 {
 protected:
-  BinContainerArea(const AreaRef& area) : child(area) { }
+  BinContainerArea(const AreaRef& area, Kind k = KArea) : ContainerArea(k), child(area) { }
   virtual ~BinContainerArea() { }
 
 public:
@@ -52,6 +52,7 @@ public:
 
   virtual bool searchByArea(class AreaId&, const AreaRef&) const;
   virtual bool searchByCoords(class AreaId&, const scaled&, const scaled&) const;
+  virtual void indexByCoords(class SpatialIndex&, const scaled&, const scaled&) const;
   virtual bool searchByIndex(class AreaId&, CharIndex) const;
 
   virtual SmartPtr<const class GlyphStringArea> getGlyphStringArea(void) const;  
@@ -25,10 +25,11 @@
 #include <cassert>
 
 #include "BoxArea.hh"
+#include "SpatialIndex.hh"
 #include "Rectangle.hh"
 
-BoxArea::BoxArea(const AreaRef& area, const BoundingBox& b)
-  : BinContainerArea(area->fit(b.width, b.height, b.depth)), bbox(b)
+BoxArea::BoxArea(const AreaRef& area, const BoundingBox& b, Kind kind)
+  : BinContainerArea(area->fit(b.width, b.height, b.depth), kind), bbox(b)
 { }
 
 AreaRef
@@ -62,3 +63,14 @@ BoxArea::searchByCoords(AreaId& id, const scaled& x, const scaled& y) const
   else
     return false;
 }
+
+void
+BoxArea::indexByCoords(SpatialIndex& index, const scaled& x, const scaled& y) const
+{
+  // the child is searched only within the box, and the box itself is
+  // found when the child is not
+  index.pushClip(x, y, box());
+  BinContainerArea::indexByCoords(index, x, y);
+  index.popClip();
+  index.add(x, y, box());
+}
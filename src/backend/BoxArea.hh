@@ -28,7 +28,7 @@
 class BoxArea : public BinContainerArea
 {
 protected:
-  BoxArea(const AreaRef&, const BoundingBox&);
+  BoxArea(const AreaRef&, const BoundingBox&, Kind = KArea);
   virtual ~BoxArea() { }
 
 public:
@@ -40,6 +40,7 @@ public:
   virtual void strength(int&, int&, int&) const;
 
   virtual bool searchByCoords(class AreaId&, const scaled&, const scaled&) const;
+  virtual void indexByCoords(class SpatialIndex&, const scaled&, const scaled&) const;
 
 private:
   BoundingBox bbox;
@@ -27,12 +27,16 @@
 #include "AreaId.hh"
 #include "Point.hh"
 #include "BoxedLayoutArea.hh"
+#include "SpatialIndex.hh"
+#include "RenderingContext.hh"
 
 void
 BoxedLayoutArea::render(class RenderingContext& context, const scaled& x, const scaled& y) const
 {
+  const bool clipped = context.hasClipRectangle();
   for (const auto & elem : content)
-    elem.area->render(context, x + elem.dx, y + elem.dy);
+    if (!clipped || context.visible(x + elem.dx, y + elem.dy, elem.area->box()))
+      elem.area->render(context, x + elem.dx, y + elem.dy);
 }
 
 bool
@@ -71,6 +75,19 @@ BoxedLayoutArea::searchByCoords(AreaId& id, const scaled& x, const scaled& y) co
   return false;
 }
 
+void
+BoxedLayoutArea::indexByCoords(SpatialIndex& index, const scaled& x, const scaled& y) const
+{
+  for (auto p = content.rbegin();
+       p != content.rend();
+       p++)
+    {
+      index.push(content.size() - (p - content.rbegin()) - 1, p->area, p->dx, p->dy);
+      p->area->indexByCoords(index, x + p->dx, y + p->dy);
+      index.pop();
+    }
+}
+
 bool
 BoxedLayoutArea::searchByIndex(AreaId& id, CharIndex index) const
 {
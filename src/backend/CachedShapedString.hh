@@ -23,6 +23,8 @@
 #ifndef __CachedShapedString_hh__
 #define __CachedShapedString_hh__
 
+#include "Area.hh"
+#include "MathVariant.hh"
 #include "String.hh"
 #include "StringHash.hh"
 
@@ -69,4 +71,28 @@ struct CachedShapedStretchyStringKeyHash
       ^ key.spanH.getValue() ^ key.spanV.getValue(); }
 };
 
+// Estimated footprint of a cache entry: the key, the source string,
+// the bookkeeping of the cache itself and the tree of areas it
+// retains, at a typical size per area. The areas shared with the
+// formatted tree or with other entries are counted all the same, so
+// the estimate errs on the large side.
+struct CachedShapedStringCost
+{
+  size_t operator()(const CachedShapedStringKey& key, const AreaRef& area) const
+  { return sizeof(key) + key.source.capacity() + sizeof(AreaRef) + 4 * sizeof(void*) + areaCost(area); }
+  size_t operator()(const CachedShapedStretchyStringKey& key, const AreaRef& area) const
+  { return sizeof(key) + key.source.capacity() + sizeof(AreaRef) + 4 * sizeof(void*) + areaCost(area); }
+
+  static size_t areaCost(const AreaRef& area)
+  {
+    if (!area) return 0;
+    size_t cost = AREA_COST;
+    for (AreaIndex i = 0; i < area->size(); i++)
+      cost += areaCost(area->node(i));
+    return cost;
+  }
+
+  static const size_t AREA_COST = 64;
+};
+
 #endif // __CachedShapedString_hh__
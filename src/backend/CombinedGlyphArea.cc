@@ -21,6 +21,7 @@
 // <http://www.gnu.org/licenses/>.
 
 #include "CombinedGlyphArea.hh"
+#include "SpatialIndex.hh"
 #include "ContainerArea.hh"
 #include "Rectangle.hh"
 #include "GlyphArea.hh"
@@ -124,6 +125,12 @@ CombinedGlyphArea::searchByCoords(class AreaId& id, const scaled& x, const scale
   return Rectangle(scaled::zero(), scaled::zero(), bbox).isInside(x, y);
 }
 
+void
+CombinedGlyphArea::indexByCoords(SpatialIndex& index, const scaled& x, const scaled& y) const
+{
+  index.add(x, y, bbox);
+}
+
 bool 
 CombinedGlyphArea::searchByIndex(class AreaId&, CharIndex) const
 {
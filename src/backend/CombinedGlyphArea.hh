@@ -56,6 +56,7 @@ public:
 
   virtual bool searchByArea(class AreaId&, const AreaRef&) const;
   virtual bool searchByCoords(class AreaId&, const scaled&, const scaled&) const;
+  virtual void indexByCoords(class SpatialIndex&, const scaled&, const scaled&) const;
   virtual bool searchByIndex(class AreaId&, CharIndex) const;
 
   virtual bool indexOfPosition(const scaled&, const scaled&, CharIndex&) const;
@@ -28,7 +28,7 @@
 class ContainerArea : public Area
 {
 protected:
-  ContainerArea(void) { }
+  ContainerArea(Kind k = KArea) : Area(k) { }
   virtual ~ContainerArea() { }
 };
 
@@ -31,7 +31,7 @@
 #include <iostream>
 
 FormattingContext::FormattingContext(const SmartPtr<MathGraphicDevice>& md)
-  : mathGraphicDevice(md)
+  : mathGraphicDevice(md), formattedElementCount(0), scope(0)
 {
   setMathMode(true);
   setSize(mathGraphicDevice->evaluate(*this, Length(10.0, Length::PT_UNIT), scaled::zero()));
@@ -39,7 +39,7 @@ FormattingContext::FormattingContext(const SmartPtr<MathGraphicDevice>& md)
   setVariant(NORMAL_VARIANT);
   setColor(RGBColor::BLACK());
   setBackground(RGBColor::WHITE());
-  set<int>(SCRIPT_LEVEL, 0);
+  intLog.set(scriptLevel, 0, scope);
   setMinSize(mathGraphicDevice->evaluate(*this, Length(6.0, Length::PT_UNIT), scaled::zero()));
   setDisplayStyle(false);
   setSizeMultiplier(0.71);
@@ -65,27 +65,27 @@ FormattingContext::addScriptLevel(int dl)
   scaled aSize = getActualSize() * pow(getSizeMultiplier(), dl);
   setActualSize(aSize);
   setSize(std::max(getMinSize(), aSize));
-  set<int>(SCRIPT_LEVEL, getScriptLevel() + dl);
+  intLog.set(scriptLevel, getScriptLevel() + dl, scope);
 }
 
 SmartPtr<class MathMLElement>
 FormattingContext::getStretchOperator() const
-{ return get< SmartPtr<MathMLElement> >(STRETCH_OP); }
+{ return stretchOperator.value; }
 
 void
 FormattingContext::setStretchOperator(const SmartPtr<MathMLElement>& op)
-{ set< SmartPtr<MathMLElement> >(STRETCH_OP, op); }
+{ elementLog.set(stretchOperator, op, scope); }
 
 void
 FormattingContext::push(const SmartPtr<MathMLElement>& el)
 {
   push();
-  set(MATHML_ELEMENT, el);
+  elementLog.set(mathmlElement, el, scope);
 }
 
 SmartPtr<MathMLElement> 
 FormattingContext::getMathMLElement() const
-{ return get<SmartPtr<MathMLElement> >(MATHML_ELEMENT); }
+{ return mathmlElement.value; }
 
 SmartPtr<MathGraphicDevice>
 FormattingContext::MGD() const
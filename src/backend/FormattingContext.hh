@@ -23,18 +23,24 @@
 #ifndef __FormattingContext_hh__
 #define __FormattingContext_hh__
 
+#include <cassert>
+
 #include "scaled.hh"
-#include "Variant.hh"
+#include "SmartPtr.hh"
 #include "RGBColor.hh"
 #include "Length.hh"
 #include "MathVariant.hh"
-#include "FastScopedHashMap.hh"
+#include "ScopedValue.hh"
 
 class FormattingContext
 {
 public:
   FormattingContext(const SmartPtr<class MathGraphicDevice>&);
   ~FormattingContext();
+  // the scoped values log pointers to slots of the context itself, so
+  // a copy would restore the bindings of the original
+  FormattingContext(const FormattingContext&) = delete;
+  FormattingContext& operator=(const FormattingContext&) = delete;
 
   enum PropertyId {
     MATH_MODE,
@@ -74,67 +80,113 @@ public:
     LAST_NAMED_PROPERTY_ENTRY
   };
 
-  bool getMathMode(void) const { return get<bool>(MATH_MODE); }
-  void setMathMode(bool m) { set<bool>(MATH_MODE, m); }
-  scaled getSize(void) const { return get<scaled>(SIZE); }
-  void setSize(const scaled& s) { set<scaled>(SIZE, s); }
-  scaled getActualSize(void) const { return get<scaled>(ACTUAL_SIZE); }
-  void setActualSize(const scaled& s) { set<scaled>(ACTUAL_SIZE, s); }
-  MathVariant getVariant(void) const { return get<MathVariant>(VARIANT); }
-  void setVariant(MathVariant v) { set<MathVariant>(VARIANT, v); }
-  RGBColor getColor(void) const { return get<RGBColor>(COLOR); }
-  void setColor(const RGBColor& c) { set<RGBColor>(COLOR, c); }
-  RGBColor getBackground(void) const { return get<RGBColor>(BACKGROUND_COLOR); }
-  void setBackground(const RGBColor& c) { set<RGBColor>(BACKGROUND_COLOR, c); }
-  int getScriptLevel(void) const { return get<int>(SCRIPT_LEVEL); }
+  bool getMathMode(void) const { return mathMode.value; }
+  void setMathMode(bool m) { boolLog.set(mathMode, m, scope); }
+  scaled getSize(void) const { return size.value; }
+  void setSize(const scaled& s) { scaledLog.set(size, s, scope); }
+  scaled getActualSize(void) const { return actualSize.value; }
+  void setActualSize(const scaled& s) { scaledLog.set(actualSize, s, scope); }
+  MathVariant getVariant(void) const { return variant.value; }
+  void setVariant(MathVariant v) { variantLog.set(variant, v, scope); }
+  RGBColor getColor(void) const { return color.value; }
+  void setColor(const RGBColor& c) { colorLog.set(color, c, scope); }
+  RGBColor getBackground(void) const { return background.value; }
+  void setBackground(const RGBColor& c) { colorLog.set(background, c, scope); }
+  int getScriptLevel(void) const { return scriptLevel.value; }
   void setScriptLevel(int l) { addScriptLevel(l - getScriptLevel()); }
   void addScriptLevel(int);
-  scaled getMinSize(void) const { return get<scaled>(MIN_SIZE); }
-  void setMinSize(scaled s) { set<scaled>(MIN_SIZE, s); }
-  bool getDisplayStyle(void) const { return get<bool>(DISPLAY_STYLE); }
-  void setDisplayStyle(bool b) { set<bool>(DISPLAY_STYLE, b); }
-  double getSizeMultiplier(void) const { return get<double>(SIZE_MULT); }
-  void setSizeMultiplier(double f) { set<double>(SIZE_MULT, f); }
-  Length getMathSpace(int i) const { return get<Length>(i); }
-  void setMathSpace(int i, const Length& l) { set<Length>(i, l); }
-  scaled getAvailableWidth(void) const { return get<scaled>(AVAILABLE_WIDTH); }
-  void setAvailableWidth(const scaled& w) { set<scaled>(AVAILABLE_WIDTH, w); }
+  scaled getMinSize(void) const { return minSize.value; }
+  void setMinSize(scaled s) { scaledLog.set(minSize, s, scope); }
+  bool getDisplayStyle(void) const { return displayStyle.value; }
+  void setDisplayStyle(bool b) { boolLog.set(displayStyle, b, scope); }
+  double getSizeMultiplier(void) const { return sizeMultiplier.value; }
+  void setSizeMultiplier(double f) { doubleLog.set(sizeMultiplier, f, scope); }
+  Length getMathSpace(int i) const { return mathSpace[mathSpaceIndex(i)].value; }
+  void setMathSpace(int i, const Length& l) { lengthLog.set(mathSpace[mathSpaceIndex(i)], l, scope); }
+  scaled getAvailableWidth(void) const { return availableWidth.value; }
+  void setAvailableWidth(const scaled& w) { scaledLog.set(availableWidth, w, scope); }
   SmartPtr<class MathMLElement> getStretchOperator(void) const;
   void setStretchOperator(const SmartPtr<class MathMLElement>&);
-  scaled getStretchToWidth(void) const { return get<scaled>(STRETCH_TO_WIDTH); }
-  void setStretchToWidth(const scaled& w) { set<scaled>(STRETCH_TO_WIDTH, w); }
-  scaled getStretchToHeight(void) const { return get<scaled>(STRETCH_TO_HEIGHT); }
-  void setStretchToHeight(const scaled& h) { set<scaled>(STRETCH_TO_HEIGHT, h); }
-  scaled getStretchToDepth(void) const { return get<scaled>(STRETCH_TO_DEPTH); }
-  void setStretchToDepth(const scaled& d) { set<scaled>(STRETCH_TO_DEPTH, d); }
-  scaled getStretchH(void) const { return get<scaled>(STRETCH_HORIZ); }
-  void setStretchH(const scaled& h) { set<scaled>(STRETCH_HORIZ, h); }
-  scaled getStretchV(void) const { return get<scaled>(STRETCH_VERT); }
-  void setStretchV(const scaled& v) { set<scaled>(STRETCH_VERT, v); }
+  scaled getStretchToWidth(void) const { return stretchToWidth.value; }
+  void setStretchToWidth(const scaled& w) { scaledLog.set(stretchToWidth, w, scope); }
+  scaled getStretchToHeight(void) const { return stretchToHeight.value; }
+  void setStretchToHeight(const scaled& h) { scaledLog.set(stretchToHeight, h, scope); }
+  scaled getStretchToDepth(void) const { return stretchToDepth.value; }
+  void setStretchToDepth(const scaled& d) { scaledLog.set(stretchToDepth, d, scope); }
+  scaled getStretchH(void) const { return stretchH.value; }
+  void setStretchH(const scaled& h) { scaledLog.set(stretchH, h, scope); }
+  scaled getStretchV(void) const { return stretchV.value; }
+  void setStretchV(const scaled& v) { scaledLog.set(stretchV, v, scope); }
 
   void push(const SmartPtr<class MathMLElement>&);
   SmartPtr<class MathMLElement> getMathMLElement(void) const;
+  // every element counts itself once each time it is laid out again,
+  // elements such as fractions push themselves more than once
+  void countFormattedElement(void) { formattedElementCount++; }
+  unsigned getFormattedElementCount(void) const { return formattedElementCount; }
   SmartPtr<class MathGraphicDevice> MGD(void) const;
 
-protected:
-  template <typename T>
-  void set(int id, const T& v)
-  { map.set(id, Variant<T>::create(v)); }
-
-  template <typename T>
-  T get(int id) const
-  { return as<T>(map.get(id)); }
-
-public:
   void push(void)
-  { map.push(); }
+  { scope++; }
 
-  void pop()
-  { map.pop(); }
+  void pop(void)
+  {
+    assert(scope > 0);
+    boolLog.undo(scope);
+    intLog.undo(scope);
+    doubleLog.undo(scope);
+    scaledLog.undo(scope);
+    variantLog.undo(scope);
+    colorLog.undo(scope);
+    lengthLog.undo(scope);
+    elementLog.undo(scope);
+    scope--;
+  }
 
 private:
+  static int mathSpaceIndex(int i)
+  {
+    assert(i >= NEGATIVE_VERYVERYTHICK_SPACE && i <= VERYVERYTHICK_SPACE);
+    return i - NEGATIVE_VERYVERYTHICK_SPACE;
+  }
+
   SmartPtr<class MathGraphicDevice> mathGraphicDevice;
-  FastScopedHashMap<LAST_NAMED_PROPERTY_ENTRY, SmartPtr<Value> > map;
+  unsigned formattedElementCount;
+
+  // Every property has a slot of its own type. Rebinding a property
+  // in a nested scope saves the previous binding in the log for that
+  // type, from which pop restores it
+  unsigned scope;
+  ScopedValueLog<bool> boolLog;
+  ScopedValueLog<int> intLog;
+  ScopedValueLog<double> doubleLog;
+  ScopedValueLog<scaled> scaledLog;
+  ScopedValueLog<MathVariant> variantLog;
+  ScopedValueLog<RGBColor> colorLog;
+  ScopedValueLog<Length> lengthLog;
+  // elements are owned by the tree being formatted, which outlives
+  // the context
+  ScopedValueLog<class MathMLElement*> elementLog;
+
+  ScopedValue<bool> mathMode;
+  ScopedValue<scaled> size;
+  ScopedValue<scaled> actualSize;
+  ScopedValue<MathVariant> variant;
+  ScopedValue<RGBColor> color;
+  ScopedValue<RGBColor> background;
+  ScopedValue<int> scriptLevel;
+  ScopedValue<scaled> minSize;
+  ScopedValue<bool> displayStyle;
+  ScopedValue<double> sizeMultiplier;
+  ScopedValue<class MathMLElement*> mathmlElement;
+  ScopedValue<scaled> availableWidth;
+  ScopedValue<class MathMLElement*> stretchOperator;
+  ScopedValue<scaled> stretchToWidth;
+  ScopedValue<scaled> stretchToHeight;
+  ScopedValue<scaled> stretchToDepth;
+  ScopedValue<scaled> stretchH;
+  ScopedValue<scaled> stretchV;
+  ScopedValue<Length> mathSpace[VERYVERYTHICK_SPACE - NEGATIVE_VERYVERYTHICK_SPACE + 1];
 };
 
 #endif // __FormattingContext_hh__
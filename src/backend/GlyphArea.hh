@@ -29,10 +29,12 @@
 class GlyphArea : public SimpleArea
 {
 protected:
-  GlyphArea(void) { }
+  GlyphArea(void) : SimpleArea(KGlyphArea) { }
   virtual ~GlyphArea();
 
 public:
+  DECLARE_KIND(GlyphArea, Area, KGlyphArea, KGlyphArea)
+
   virtual bool indexOfPosition(const scaled&, const scaled&, CharIndex&) const;
   virtual bool positionOfIndex(CharIndex, struct Point*, BoundingBox*) const;
   virtual bool searchByIndex(AreaId&, CharIndex) const;
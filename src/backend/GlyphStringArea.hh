@@ -30,11 +30,13 @@ class GlyphStringArea : public HorizontalArrayArea
 {
 protected:
   GlyphStringArea(const std::vector<AreaRef>& children, const std::vector<CharIndex>& c, const UCS4String& s)
-    : HorizontalArrayArea(children), counters(c), source(s)
+    : HorizontalArrayArea(children, KGlyphStringArea), counters(c), source(s)
   { assert(children.size() == counters.size()); }
   virtual ~GlyphStringArea() { }
 
 public:
+  DECLARE_KIND(GlyphStringArea, Area, KGlyphStringArea, KGlyphStringArea)
+
   static SmartPtr<GlyphStringArea> create(const std::vector<AreaRef>& children, const std::vector<CharIndex>& c, const UCS4String& s)
   { return new GlyphStringArea(children, c, s); }
   virtual AreaRef clone(const std::vector<AreaRef>& c) const { return create(c, counters, source); }
@@ -25,6 +25,7 @@
 #include <cassert>
 
 #include "GlyphWrapperArea.hh"
+#include "SpatialIndex.hh"
 #include "Rectangle.hh"
 
 AreaRef
@@ -73,6 +74,10 @@ bool
 GlyphWrapperArea::searchByCoords(AreaId&, const scaled& x, const scaled& y) const
 { return Rectangle(scaled::zero(), scaled::zero(), box()).isInside(x, y); }
 
+void
+GlyphWrapperArea::indexByCoords(SpatialIndex& index, const scaled& x, const scaled& y) const
+{ index.add(x, y, box()); }
+
 bool
 GlyphWrapperArea::searchByIndex(AreaId&, CharIndex index) const
 { return index >= 0 && index < contentLength; }
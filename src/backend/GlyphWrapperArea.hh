@@ -46,6 +46,7 @@ public:
   virtual bool positionOfIndex(CharIndex, struct Point*, BoundingBox*) const;
   virtual bool searchByArea(class AreaId&, const AreaRef&) const;
   virtual bool searchByCoords(class AreaId&, const scaled&, const scaled&) const;
+  virtual void indexByCoords(class SpatialIndex&, const scaled&, const scaled&) const;
   virtual bool searchByIndex(class AreaId&, CharIndex) const;
   
 private:
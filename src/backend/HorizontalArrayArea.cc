@@ -25,6 +25,36 @@
 #include "AreaId.hh"
 #include "Point.hh"
 #include "HorizontalArrayArea.hh"
+#include "SpatialIndex.hh"
+#include "RenderingContext.hh"
+
+HorizontalArrayArea::HorizontalArrayArea(const std::vector<AreaRef>& children, Kind kind)
+  : LinearContainerArea(children, kind)
+{
+  childOrigin.reserve(content.size());
+  Point p;
+  for (const auto & elem : content)
+    {
+      childOrigin.push_back(p);
+      const BoundingBox pbox = elem->box();
+      const scaled childStep = elem->getStep();
+      cachedBox.append(pbox);
+      cachedBox.height -= childStep;
+      cachedBox.depth += childStep;
+
+      const scaled ledge = elem->leftEdge();
+      if (ledge < scaled::max()) cachedLeftEdge = std::min(cachedLeftEdge, p.x + ledge);
+      const scaled redge = elem->rightEdge();
+      if (redge > scaled::min()) cachedRightEdge = std::max(cachedRightEdge, p.x + redge);
+
+      p.x += pbox.horizontalExtent();
+      p.y += childStep;
+    }
+  // must restore the baseline
+  cachedBox.height += p.y;
+  cachedBox.depth -= p.y;
+  cachedStep = p.y;
+}
 
 SmartPtr<HorizontalArrayArea>
 HorizontalArrayArea::create(const std::vector<AreaRef>& children)
@@ -48,7 +78,8 @@ HorizontalArrayArea::flattenAux(std::vector<AreaRef>& dest, const std::vector<Ar
 AreaRef
 HorizontalArrayArea::flatten(void) const
 {
-  std::vector<AreaRef> newContent(content.size());
+  std::vector<AreaRef> newContent;
+  newContent.reserve(content.size());
   flattenAux(newContent, content);
   if (newContent != content)
     return clone(newContent);
@@ -56,82 +87,41 @@ HorizontalArrayArea::flatten(void) const
     return this;
 }
 
-BoundingBox
-HorizontalArrayArea::box() const
-{
-  BoundingBox bbox;
-  scaled step = 0;
-  for (const auto & elem : content)
-    {
-      bbox.append(elem->box());
-      const scaled childStep = elem->getStep();
-      bbox.height -= childStep;
-      bbox.depth += childStep;
-      step += childStep;
-    }
-  // must restore the baseline
-  bbox.height += step;
-  bbox.depth -= step;
-
-  return bbox;
-}
-
 void
 HorizontalArrayArea::render(class RenderingContext& context, const scaled& x0, const scaled& y0) const
 {
-  scaled x = x0;
-  scaled y = y0;
-  for (const auto & elem : content)
+  for (auto p = content.begin(); p != content.end(); p++)
     {
-      elem->render(context, x, y);
-      x += elem->box().horizontalExtent();
-      y += elem->getStep();
+      const Point& o = childOrigin[p - content.begin()];
+      if (context.visible(x0 + o.x, y0 + o.y, (*p)->box()))
+        (*p)->render(context, x0 + o.x, y0 + o.y);
     }
 }
 
 bool
 HorizontalArrayArea::searchByCoords(AreaId& id, const scaled& x, const scaled& y0) const
 {
-  scaled offset;
-  scaled y = y0;
   for (auto p = content.begin(); p != content.end(); p++)
     {
-      id.append(p - content.begin(), *p, offset, scaled::zero());
-      if ((*p)->searchByCoords(id, x - offset, y)) return true;
+      const Point& o = childOrigin[p - content.begin()];
+      id.append(p - content.begin(), *p, o.x, scaled::zero());
+      if ((*p)->searchByCoords(id, x - o.x, y0 + o.y)) return true;
       id.pop_back();
-      offset += (*p)->box().horizontalExtent();
-      y += (*p)->getStep();
     }
 
   return false;
 }
 
-scaled
-HorizontalArrayArea::leftEdge() const
-{
-  scaled edge = scaled::max();
-  scaled d = 0;
-  for (const auto & elem : content)
-    {
-      scaled pedge = elem->leftEdge();
-      if (pedge < scaled::max()) edge = std::min(edge, d + pedge);
-      d += elem->box().horizontalExtent();
-    }
-  return edge;
-}
-
-scaled
-HorizontalArrayArea::rightEdge() const
+void
+HorizontalArrayArea::indexByCoords(SpatialIndex& index, const scaled& x, const scaled& y0) const
 {
-  scaled edge = scaled::min();
-  scaled d = 0;
-  for (const auto & elem : content)
+  for (auto p = content.begin(); p != content.end(); p++)
     {
-      scaled pedge = elem->rightEdge();
-      if (pedge > scaled::min()) edge = std::max(edge, d + pedge);
-      d += elem->box().horizontalExtent();
+      const Point& o = childOrigin[p - content.begin()];
+      index.push(p - content.begin(), *p, o.x, scaled::zero());
+      (*p)->indexByCoords(index, x + o.x, y0 - o.y);
+      index.pop();
     }
-  return edge;
 }
 
 scaled
@@ -210,18 +200,6 @@ void
 HorizontalArrayArea::origin(AreaIndex i, Point& point) const
 {
   assert(i >= 0 && i < content.size());
-  for (auto p = content.begin(); p != content.begin() + i; p++)
-    {
-      point.x += (*p)->box().horizontalExtent();
-      point.y += (*p)->getStep();
-    }
-}
-
-scaled
-HorizontalArrayArea::getStep() const
-{
-  scaled step = 0;
-  for (const auto & elem : content)
-    step += elem->getStep();
-  return step;
+  point.x += childOrigin[i].x;
+  point.y += childOrigin[i].y;
 }
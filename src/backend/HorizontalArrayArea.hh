@@ -24,34 +24,40 @@
 #define __HorizontalArrayArea_hh__
 
 #include "LinearContainerArea.hh"
+#include "Point.hh"
 
 class HorizontalArrayArea : public LinearContainerArea
 {
 protected:
-  HorizontalArrayArea(const std::vector<AreaRef>& children) : LinearContainerArea(children) { }
+  HorizontalArrayArea(const std::vector<AreaRef>&, Kind = KHorizontalArrayArea);
   virtual ~HorizontalArrayArea() { }
 
 public:
+  DECLARE_KIND(HorizontalArrayArea, Area, KHorizontalArrayArea, KGlyphStringArea)
+
   static SmartPtr<HorizontalArrayArea> create(const std::vector<AreaRef>&);
   virtual AreaRef clone(const std::vector<AreaRef>& c) const { return create(c); }
 
   virtual AreaRef flatten(void) const;
-  virtual BoundingBox box(void) const;
+  virtual BoundingBox box(void) const { return cachedBox; }
   virtual void render(class RenderingContext&, const scaled&, const scaled&) const;
-  virtual scaled leftEdge(void) const;
-  virtual scaled rightEdge(void) const;
   virtual AreaRef fit(const scaled&, const scaled&, const scaled&) const;
   virtual void strength(int&, int&, int&) const;
   virtual void origin(AreaIndex, struct Point&) const;
-  virtual scaled getStep(void) const;
+  virtual scaled getStep(void) const { return cachedStep; }
 
   virtual bool searchByCoords(class AreaId&, const scaled&, const scaled&) const;
+  virtual void indexByCoords(class SpatialIndex&, const scaled&, const scaled&) const;
 
   scaled leftSide(AreaIndex) const;
   scaled rightSide(AreaIndex) const;
 
 private:
   static void flattenAux(std::vector<AreaRef>&, const std::vector<AreaRef>&);
+
+  BoundingBox cachedBox;
+  scaled cachedStep;
+  std::vector<Point> childOrigin;
 };
 
 #endif // __HorizontalArrayArea_hh__
@@ -24,12 +24,38 @@
 #include "LinearContainerArea.hh"
 #include "GlyphStringArea.hh"
 #include "GlyphArea.hh"
+#include "RenderingContext.hh"
+
+LinearContainerArea::LinearContainerArea(const std::vector<AreaRef>& c, Kind kind)
+  : ContainerArea(kind), content(c), cachedLeftEdge(scaled::max()), cachedRightEdge(scaled::min())
+{
+  lengthPrefix.reserve(content.size() + 1);
+  CharIndex length = 0;
+  lengthPrefix.push_back(length);
+  for (const auto & elem : content)
+    {
+      length += elem->length();
+      lengthPrefix.push_back(length);
+    }
+}
+
+void
+LinearContainerArea::initEdges()
+{
+  for (const auto & elem : content)
+    {
+      cachedLeftEdge = std::min(cachedLeftEdge, elem->leftEdge());
+      cachedRightEdge = std::max(cachedRightEdge, elem->rightEdge());
+    }
+}
 
 void
 LinearContainerArea::render(class RenderingContext& context, const scaled& x, const scaled& y) const
 {
+  const bool clipped = context.hasClipRectangle();
   for (const auto & elem : content)
-    elem->render(context, x, y);
+    if (!clipped || context.visible(x, y, elem->box()))
+      elem->render(context, x, y);
 }
 
 bool
@@ -62,24 +88,6 @@ LinearContainerArea::searchByIndex(AreaId& id, CharIndex index) const
   return false;
 }
 
-scaled
-LinearContainerArea::leftEdge(void) const
-{
-  scaled edge = scaled::max();
-  for (const auto & elem : content)
-    edge = std::min(edge, elem->leftEdge());
-  return edge;
-}
-
-scaled
-LinearContainerArea::rightEdge(void) const
-{
-  scaled edge = scaled::min();
-  for (const auto & elem : content)
-    edge = std::max(edge, elem->rightEdge());
-  return edge;
-}
-
 AreaRef
 LinearContainerArea::node(AreaIndex i) const
 {
@@ -91,10 +99,7 @@ CharIndex
 LinearContainerArea::lengthTo(AreaIndex i) const
 {
   assert(i >= 0 && i < content.size());
-  CharIndex length = 0;
-  for (auto p = content.begin(); p != content.begin() + i; p++)
-    length += (*p)->length();
-  return length;
+  return lengthPrefix[i];
 }
 
 SmartPtr<const GlyphStringArea>
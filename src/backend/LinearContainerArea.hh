@@ -30,15 +30,15 @@
 class LinearContainerArea : public ContainerArea
 {
 protected:
-  LinearContainerArea(const std::vector<AreaRef>& c) : content(c) { }
+  LinearContainerArea(const std::vector<AreaRef>&, Kind = KArea);
   virtual ~LinearContainerArea() { }
 
 public:
   virtual AreaRef clone(const std::vector<AreaRef>&) const = 0;
 
   virtual void render(class RenderingContext&, const scaled&, const scaled&) const;
-  virtual scaled leftEdge(void) const;
-  virtual scaled rightEdge(void) const;
+  virtual scaled leftEdge(void) const { return cachedLeftEdge; }
+  virtual scaled rightEdge(void) const { return cachedRightEdge; }
   virtual AreaIndex size(void) const { return content.size(); }
   virtual AreaRef node(AreaIndex) const;
   virtual CharIndex lengthTo(AreaIndex) const;
@@ -52,7 +52,17 @@ public:
   const std::vector<AreaRef> getChildren(void) const { return content; }
 
 protected:
+  // sets the edges of a container whose children all have the same
+  // origin. Containers with other layouts compute their own
+  void initEdges(void);
+
   std::vector<AreaRef> content;
+  // Areas are immutable, hence everything that depends on the children
+  // only is computed once by the constructors rather than by walking
+  // the children at every query
+  std::vector<CharIndex> lengthPrefix; // length of the first i children
+  scaled cachedLeftEdge;
+  scaled cachedRightEdge;
 };
 
 #endif // __LinearContainerArea_hh__
@@ -22,12 +22,37 @@
 
 #include <config.h>
 
+#include <algorithm>
+
 #include "MathFont.hh"
 
-MathFont::MathFont(const hb_font_t* font)
+// bounds-checked big-endian reader over the MATH table. Reading out
+// of the table yields zeroes, which the decoder treats as missing
+// subtables
+class MathFont::TableReader
+{
+public:
+  TableReader(const char* d, unsigned l) : data(d), length(l) { }
+
+  uint16_t u16(unsigned offset) const
+  {
+    if (!data || offset + 2 > length) return 0;
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data) + offset;
+    return (p[0] << 8) | p[1];
+  }
+
+  int16_t s16(unsigned offset) const { return static_cast<int16_t>(u16(offset)); }
+
+private:
+  const char* data;
+  unsigned length;
+};
+
+MathFont::MathFont(hb_blob_t* table)
+  : m_table(table), m_minConnectorOverlap(0)
 {
-  hb_face_t* face = hb_font_get_face(const_cast<hb_font_t*>(font));
-  m_table = hb_face_reference_table(const_cast<hb_face_t*>(face), HB_TAG('M','A','T','H'));
+  std::fill(m_constants, m_constants + lastMathConstant + 1, 0);
+  decodeTable();
 }
 
 MathFont::~MathFont()
@@ -36,103 +61,176 @@ MathFont::~MathFont()
 }
 
 SmartPtr<MathFont>
-MathFont::create(const hb_font_t* font)
+MathFont::create(hb_blob_t* table)
 {
-  return new MathFont(font);
+  return new MathFont(table);
 }
 
-int
-MathFont::getConstant(MathConstant constant) const
+void
+MathFont::decodeTable()
 {
-  int value = 0;
-  const char* tableData = hb_blob_get_data(const_cast<hb_blob_t*>(m_table), nullptr);
-  if (tableData)
+  const TableReader table(getTableData(), getTableLength());
+
+  // MathTableHeader: version, mathConstants, mathGlyphInfo, mathVariants
+  if (const unsigned constants = table.u16(4))
+    for (int constant = 0; constant <= lastMathConstant; constant++)
+      {
+	if (constant < firstMathValueRecord)
+	  // it's a simple 16-bit value
+	  m_constants[constant] = table.u16(constants + 2 * constant);
+	else if (constant <= lastMathValueRecord)
+	  // a MathValueRecord, the value is followed by a device offset
+	  m_constants[constant] = table.s16(constants + 2 * firstMathValueRecord + 4 * (constant - firstMathValueRecord));
+	else
+	  m_constants[constant] = table.u16(constants + 2 * (constant + lastMathValueRecord - firstMathValueRecord + 1));
+      }
+
+  const unsigned variants = table.u16(8);
+  if (!variants) return;
+
+  // MathVariants: minConnectorOverlap, vertGlyphCoverage,
+  // horizGlyphCoverage, vertGlyphCount, horizGlyphCount and the
+  // offsets of the vertical then of the horizontal constructions
+  m_minConnectorOverlap = table.u16(variants);
+  const unsigned vertCount = table.u16(variants + 6);
+  const unsigned horizCount = table.u16(variants + 8);
+
+  m_constructions.reserve(vertCount + horizCount);
+  for (unsigned i = 0; i < vertCount + horizCount; i++)
     {
-      const uint16_t* constants = (const uint16_t*)(tableData + SWAP(((const MathTableHeader*)tableData)->mathConstants));
-      if (constant < firstMathValueRecord)
-        {
-          /* it's a simple 16-bit value */
-          value =  SWAP(constants[constant]);
-        }
-      else if (constant <= lastMathValueRecord)
-        {
-          const MathValueRecord* valueRecords = (const MathValueRecord*)
-              ((char*)constants + firstMathValueRecord * sizeof(uint16_t) - firstMathValueRecord * sizeof(MathValueRecord));
-          value =  SWAP(valueRecords[constant].value);
-        }
-      else if (constant <= lastMathConstant)
-        {
-          value =  SWAP(constants[constant + (lastMathValueRecord - firstMathValueRecord + 1)]);
-        }
+      ConstructionRecord record = { 0, 0, 0, 0, 0 };
+      if (const unsigned offset = table.u16(variants + 10 + 2 * i))
+	{
+	  const unsigned construction = variants + offset;
+	  record.firstVariant = m_variants.size();
+	  record.variantCount = table.u16(construction + 2);
+	  for (unsigned j = 0; j < record.variantCount; j++)
+	    {
+	      GlyphVariant variant;
+	      variant.glyph = table.u16(construction + 4 + 4 * j);
+	      variant.advance = table.u16(construction + 6 + 4 * j);
+	      m_variants.push_back(variant);
+	    }
+
+	  if (const unsigned assemblyOffset = table.u16(construction))
+	    {
+	      const unsigned assembly = construction + assemblyOffset;
+	      record.italicsCorrection = table.s16(assembly);
+	      record.firstPart = m_parts.size();
+	      record.partCount = table.u16(assembly + 4);
+	      for (unsigned j = 0; j < record.partCount; j++)
+		{
+		  const unsigned partRecord = assembly + 6 + 10 * j;
+		  GlyphPart part;
+		  part.glyph = table.u16(partRecord);
+		  part.startConnectorLength = table.u16(partRecord + 2);
+		  part.endConnectorLength = table.u16(partRecord + 4);
+		  part.fullAdvance = table.u16(partRecord + 6);
+		  part.extender = table.u16(partRecord + 8) & 0x0001;
+		  m_parts.push_back(part);
+		}
+	    }
+	}
+      m_constructions.push_back(record);
     }
 
-  return value;
+  decodeCoverage(table, variants, table.u16(variants + 2), 0, vertCount, m_vertCoverage);
+  decodeCoverage(table, variants, table.u16(variants + 4), vertCount, horizCount, m_horizCoverage);
 }
 
-static int32_t getCoverage(const Coverage* coverage, GlyphID g)
+void
+MathFont::decodeCoverage(const TableReader& table, unsigned base, unsigned offset,
+			 unsigned firstConstruction, unsigned count,
+			 std::vector<std::pair<GlyphID, unsigned> >& coverage)
 {
-  if (SWAP(coverage->format) == 1)
+  if (!offset) return;
+
+  const unsigned start = base + offset;
+  const unsigned format = table.u16(start);
+  if (format == 1)
     {
-      const CoverageFormat1 *table = (const CoverageFormat1 *) coverage;
-      for (int i = 0; i < SWAP(table->glyphCount); i++)
-        {
-        if (SWAP(table->glyphArray[i]) == g)
-          return i;
-        }
+      const unsigned glyphCount = table.u16(start + 2);
+      for (unsigned i = 0; i < glyphCount && i < count; i++)
+	coverage.push_back(std::make_pair(table.u16(start + 4 + 2 * i), firstConstruction + i));
     }
-  else if (SWAP(coverage->format) == 2)
+  else if (format == 2)
     {
-      const CoverageFormat2 *table = (const CoverageFormat2 *) coverage;
-      for (int i = 0; i < SWAP(table->rangeCount); i++)
-        {
-          if (SWAP(table->rangeArray[i].start) <= g && SWAP(table->rangeArray[i].end) >= g)
-            return SWAP(table->rangeArray[i].startCoverageIndex) + (g - SWAP(table->rangeArray[i].start));
-        }
+      const unsigned rangeCount = table.u16(start + 2);
+      for (unsigned i = 0; i < rangeCount; i++)
+	{
+	  const unsigned range = start + 4 + 6 * i;
+	  const unsigned first = table.u16(range);
+	  const unsigned last = table.u16(range + 2);
+	  const unsigned index = table.u16(range + 4);
+	  for (unsigned g = first; g <= last && index + (g - first) < count; g++)
+	    coverage.push_back(std::make_pair(GlyphID(g), firstConstruction + index + (g - first)));
+	}
     }
 
-  return -1;
+  std::sort(coverage.begin(), coverage.end());
+}
+
+int
+MathFont::findConstruction(GlyphID glyph, bool horiz) const
+{
+  const std::vector<std::pair<GlyphID, unsigned> >& coverage = horiz ? m_horizCoverage : m_vertCoverage;
+  auto p = std::lower_bound(coverage.begin(), coverage.end(), std::make_pair(glyph, 0u));
+  return (p != coverage.end() && p->first == glyph) ? int(p->second) : -1;
+}
+
+bool
+MathFont::getConstruction(GlyphID glyph, bool horiz, GlyphConstruction& construction) const
+{
+  const int index = findConstruction(glyph, horiz);
+  if (index < 0) return false;
+
+  const ConstructionRecord& record = m_constructions[index];
+  construction.variants = record.variantCount ? &m_variants[record.firstVariant] : nullptr;
+  construction.variantCount = record.variantCount;
+  construction.parts = record.partCount ? &m_parts[record.firstPart] : nullptr;
+  construction.partCount = record.partCount;
+  construction.italicsCorrection = record.italicsCorrection;
+  return true;
 }
 
 unsigned
-MathFont::getVariant(int glyph, scaled size, bool horiz)
+MathFont::getVariant(int glyph, scaled size, bool horiz) const
 {
   int variant = glyph;
 
-  const char* tableData = hb_blob_get_data(const_cast<hb_blob_t*>(m_table), nullptr);
-  if (tableData)
+  const int index = findConstruction(glyph, horiz);
+  if (index >= 0)
     {
-      uint16_t offset = SWAP(((const MathTableHeader*)tableData)->mathVariants);
-      if (offset != 0)
-        {
-          const MathVariants* variants = (const MathVariants*)(tableData + offset);
-
-          if (horiz)
-            offset = SWAP(variants->horizGlyphCoverage);
-          else
-            offset = SWAP(variants->vertGlyphCoverage);
-
-          if (offset != 0)
-            {
-              const Coverage* coverage = (const Coverage*)(((const char*)variants) + offset);
-
-              int32_t index = getCoverage(coverage, glyph);
-              if (index >= 0)
-                {
-                  if (horiz)
-                    index += SWAP(variants->vertGlyphCount);
-                  const MathGlyphConstruction* construction = (const MathGlyphConstruction*)(((const char*)variants)
-                                                              + SWAP(variants->vertGlyphConstruction[index]));
-                  for (int i = 0; i < SWAP(construction->variantCount); i++)
-                    {
-                      variant = SWAP(construction->mathGlyphVariantRecord[i].variantGlyph);
-                      int adv = SWAP(construction->mathGlyphVariantRecord[i].advanceMeasurement);
-                      if (adv > size.toInt())
-                        break;
-                    }
-                }
-            }
-        }
+      const ConstructionRecord& record = m_constructions[index];
+      for (unsigned i = 0; i < record.variantCount; i++)
+	{
+	  variant = m_variants[record.firstVariant + i].glyph;
+	  if (int(m_variants[record.firstVariant + i].advance) > size.toInt())
+	    break;
+	}
     }
 
   return variant;
 }
+
+const char*
+MathFont::getTableData() const
+{
+  return hb_blob_get_data(const_cast<hb_blob_t*>(m_table), nullptr);
+}
+
+unsigned
+MathFont::getTableLength() const
+{
+  return hb_blob_get_length(const_cast<hb_blob_t*>(m_table));
+}
+
+size_t
+MathFont::getMemoryUsage() const
+{
+  return sizeof(*this) + getTableLength()
+    + (m_vertCoverage.capacity() + m_horizCoverage.capacity()) * sizeof(std::pair<GlyphID, unsigned>)
+    + m_constructions.capacity() * sizeof(ConstructionRecord)
+    + m_variants.capacity() * sizeof(GlyphVariant)
+    + m_parts.capacity() * sizeof(GlyphPart);
+}
@@ -25,25 +25,90 @@
 
 #include <hb.h>
 
+#include <vector>
+
 #include "Object.hh"
 #include "SmartPtr.hh"
 #include "scaled.hh"
 #include "MathTable.hh"
 #include "stdio.h"
 
+// The MATH table is decoded once, when the font is created, into
+// native-endian arrays: the constants, the coverage of the glyphs
+// having variants, sorted by glyph, and the glyph constructions with
+// their variants and assembly parts
+
 class MathFont : public Object
 {
 protected:
-  MathFont(const hb_font_t*);
+  MathFont(hb_blob_t*);
   virtual ~MathFont();
 
 public:
-  static SmartPtr<MathFont> create(const hb_font_t*);
-  int getConstant(MathConstant) const;
-  unsigned getVariant(int, scaled, bool);
+  // takes the ownership of the MATH table blob. MathFontRegistry::get
+  // returns instances shared by all the fonts with the same table
+  static SmartPtr<MathFont> create(hb_blob_t*);
+  int getConstant(MathConstant constant) const
+  { return (constant >= 0 && constant <= lastMathConstant) ? m_constants[constant] : 0; }
+  unsigned getVariant(int, scaled, bool) const;
+
+  struct GlyphVariant
+  {
+    GlyphID glyph;
+    unsigned advance;
+  };
+
+  struct GlyphPart
+  {
+    GlyphID glyph;
+    unsigned startConnectorLength;
+    unsigned endConnectorLength;
+    unsigned fullAdvance;
+    bool extender;
+  };
+
+  struct GlyphConstruction
+  {
+    const GlyphVariant* variants;
+    unsigned variantCount;
+    const GlyphPart* parts; // the assembly, from bottom or left
+    unsigned partCount;
+    int italicsCorrection;
+  };
+
+  // false if the glyph has no construction in the given direction
+  bool getConstruction(GlyphID, bool, GlyphConstruction&) const;
+  unsigned getMinConnectorOverlap(void) const { return m_minConnectorOverlap; }
+
+  const char* getTableData(void) const;
+  unsigned getTableLength(void) const;
+  size_t getMemoryUsage(void) const;
 
 private:
+  class TableReader;
+  void decodeTable(void);
+  static void decodeCoverage(const TableReader&, unsigned, unsigned, unsigned, unsigned,
+			     std::vector<std::pair<GlyphID, unsigned> >&);
+  int findConstruction(GlyphID, bool) const;
+
+  struct ConstructionRecord
+  {
+    unsigned firstVariant;
+    unsigned variantCount;
+    unsigned firstPart;
+    unsigned partCount;
+    int italicsCorrection;
+  };
+
   const hb_blob_t* m_table;
+  int m_constants[lastMathConstant + 1];
+  unsigned m_minConnectorOverlap;
+  // glyph and construction index, sorted by glyph
+  std::vector<std::pair<GlyphID, unsigned> > m_vertCoverage;
+  std::vector<std::pair<GlyphID, unsigned> > m_horizCoverage;
+  std::vector<ConstructionRecord> m_constructions;
+  std::vector<GlyphVariant> m_variants;
+  std::vector<GlyphPart> m_parts;
 };
 
 #endif // __MathFont_hh__
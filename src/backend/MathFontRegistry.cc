@@ -0,0 +1,117 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <config.h>
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "MathFont.hh"
+#include "MathFontRegistry.hh"
+
+namespace {
+
+  // fonts are indexed by the length of their MATH table, hence the
+  // content of two tables is compared only when their lengths collide
+  typedef std::unordered_multimap<unsigned, SmartPtr<MathFont> > Registry;
+
+  struct GuardedRegistry
+  {
+    std::mutex mutex;
+    Registry fonts;
+  };
+
+  GuardedRegistry&
+  getRegistry(void)
+  {
+    static GuardedRegistry registry;
+    return registry;
+  }
+
+}
+
+SmartPtr<MathFont>
+MathFontRegistry::get(const hb_font_t* font)
+{
+  hb_face_t* face = hb_font_get_face(const_cast<hb_font_t*>(font));
+  hb_blob_t* table = hb_face_reference_table(face, HB_TAG('M','A','T','H'));
+  unsigned length;
+  const char* data = hb_blob_get_data(table, &length);
+
+  GuardedRegistry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  auto range = registry.fonts.equal_range(length);
+  for (auto p = range.first; p != range.second; p++)
+    // faces sharing the memory of the font yield the very same table
+    if (p->second->getTableData() == data
+	|| length == 0 || memcmp(p->second->getTableData(), data, length) == 0)
+      {
+	hb_blob_destroy(table);
+	return p->second;
+      }
+
+  SmartPtr<MathFont> mathFont = MathFont::create(table);
+  registry.fonts.insert(std::make_pair(length, mathFont));
+  return mathFont;
+}
+
+std::vector<MathFontRegistry::EntryInfo>
+MathFontRegistry::getEntries()
+{
+  GuardedRegistry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  std::vector<EntryInfo> entries;
+  entries.reserve(registry.fonts.size());
+  for (const auto& p : registry.fonts)
+    {
+      EntryInfo info;
+      info.tableLength = p.second->getTableLength();
+      info.memoryUsage = p.second->getMemoryUsage();
+      info.users = p.second->getRefCount() - 1;
+      entries.push_back(info);
+    }
+
+  return entries;
+}
+
+unsigned
+MathFontRegistry::purge()
+{
+  GuardedRegistry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  // new references can only be obtained through the registry, hence a
+  // font referenced by the registry only cannot be revived while the
+  // lock is held
+  unsigned n = 0;
+  for (auto p = registry.fonts.begin(); p != registry.fonts.end(); )
+    if (p->second->getRefCount() == 1)
+      {
+	p = registry.fonts.erase(p);
+	n++;
+      }
+    else
+      p++;
+
+  return n;
+}
@@ -0,0 +1,57 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __MathFontRegistry_hh__
+#define __MathFontRegistry_hh__
+
+#include <hb.h>
+
+#include <vector>
+
+#include "SmartPtr.hh"
+
+// The registry hands out one MathFont for every distinct MATH table, so
+// that backends created for the same font, possibly by different views
+// and threads, share the table and what is derived from it. Fonts are
+// identified by the content of their MATH table, since every backend
+// creates a HarfBuzz face of its own. Whoever drops a font obtained
+// from the registry should purge it, as the MathGraphicDevice and the
+// MathShaper do when they are destroyed. All the methods are
+// thread-safe
+
+class MathFontRegistry
+{
+public:
+  static SmartPtr<class MathFont> get(const hb_font_t*);
+
+  struct EntryInfo
+  {
+    unsigned tableLength;
+    size_t memoryUsage;
+    unsigned users; // references held outside the registry
+  };
+
+  static std::vector<EntryInfo> getEntries(void);
+  // forgets the fonts that are no longer referenced outside the
+  // registry and returns how many they were
+  static unsigned purge(void);
+};
+
+#endif // __MathFontRegistry_hh__
@@ -25,7 +25,9 @@
 
 #include <cassert>
 
+#include "AreaArena.hh"
 #include "AreaFactory.hh"
+#include "MathFontRegistry.hh"
 #include "MathGraphicDevice.hh"
 #include "MathMLElement.hh"
 #include "FormattingContext.hh"
@@ -36,12 +38,19 @@
 
 MathGraphicDevice::MathGraphicDevice(const hb_font_t* font)
   : m_font(font)
+  , m_upem(hb_face_get_upem(hb_font_get_face(const_cast<hb_font_t*>(font))))
+  , stringCache(DEFAULT_CACHE_ENTRIES)
+  , stretchyStringCache(DEFAULT_CACHE_ENTRIES)
 {
-  m_mathfont = MathFont::create(font);
+  m_mathfont = MathFontRegistry::get(font);
 }
 
 MathGraphicDevice::~MathGraphicDevice()
-{ }
+{
+  // the MATH table stays in the registry as long as it is referenced
+  m_mathfont = nullptr;
+  MathFontRegistry::purge();
+}
 
 SmartPtr<MathGraphicDevice>
 MathGraphicDevice::create(const hb_font_t* font)
@@ -86,8 +95,6 @@ MathGraphicDevice::getConstant(const FormattingContext& context,
     }
 
   scaled value = m_mathfont->getConstant(constant);
-  hb_face_t* face = hb_font_get_face(const_cast<hb_font_t*>(m_font));
-  int upem = hb_face_get_upem(face);
 
   // scale the non-percent constants
   switch (constant)
@@ -97,7 +104,7 @@ MathGraphicDevice::getConstant(const FormattingContext& context,
       case radicalDegreeBottomRaisePercent:
         break;
       default:
-        value = (value * context.getSize()) / upem;
+        value = (value * context.getSize()) / m_upem;
         break;
     }
 
@@ -144,14 +151,6 @@ MathGraphicDevice::dummy(const FormattingContext& context) const
   return getFactory()->color(unstretchedString(context, StringOfUCS4String(UCS4String(1, 0xfffd))), RGBColor::RED());
 }
 
-#include "CachedShapedString.hh"
-#include <unordered_map>
-typedef std::unordered_map<CachedShapedStringKey, AreaRef, CachedShapedStringKeyHash> ShapedStringCache;
-typedef std::unordered_map<CachedShapedStretchyStringKey, AreaRef, CachedShapedStringKeyHash> ShapedStretchyStringCache;
-
-static ShapedStretchyStringCache stretchyStringCache;
-static ShapedStringCache stringCache;
-
 void
 MathGraphicDevice::clearCache() const
 {
@@ -159,37 +158,52 @@ MathGraphicDevice::clearCache() const
   stringCache.clear();
 }
 
+void
+MathGraphicDevice::setCacheLimits(size_t maxEntries, size_t maxBytes) const
+{
+  stringCache.setLimits(maxEntries, maxBytes);
+  stretchyStringCache.setLimits(maxEntries, maxBytes);
+}
+
+LRUCacheStats
+MathGraphicDevice::getCacheStats() const
+{
+  LRUCacheStats stats = stringCache.getStats();
+  stats += stretchyStringCache.getStats();
+  return stats;
+}
+
 AreaRef
 MathGraphicDevice::stretchedString(const FormattingContext& context, const String& str) const
 {
   CachedShapedStretchyStringKey key(str, context.getVariant(), context.getSize(),
                                     context.getStretchH(), context.getStretchV());
-  std::pair<ShapedStretchyStringCache::iterator, bool> r = stretchyStringCache.insert(std::make_pair(key, AreaRef(nullptr)));
-  if (r.second)
+  AreaRef area;
+  if (!stretchyStringCache.find(key, area))
     {
-      r.first->second = getShaperManager()->shapeStretchy(context,
-                                                          str,
-                                                          context.getStretchV(),
-                                                          context.getStretchH());
-      return r.first->second;
+      // cached areas outlive the formatting pass
+      AreaArena::Scope heap(nullptr);
+      area = getShaperManager()->shapeStretchy(context,
+                                               str,
+                                               context.getStretchV(),
+                                               context.getStretchH());
+      stretchyStringCache.insert(key, area);
     }
-  else
-    return r.first->second;
+  return area;
 }
 
 AreaRef
 MathGraphicDevice::unstretchedString(const FormattingContext& context, const String& str) const
 {
   CachedShapedStringKey key(str, context.getVariant(), context.getSize());
-
-  std::pair<ShapedStringCache::iterator, bool> r = stringCache.insert(std::make_pair(key, AreaRef(nullptr)));
-  if (r.second)
+  AreaRef area;
+  if (!stringCache.find(key, area))
     {
-      r.first->second = getShaperManager()->shape(context, str);
-      return r.first->second;
+      AreaArena::Scope heap(nullptr);
+      area = getShaperManager()->shape(context, str);
+      stringCache.insert(key, area);
     }
-  else
-    return r.first->second;
+  return area;
 }
 
 AreaRef
@@ -210,6 +224,8 @@ MathGraphicDevice::stretchStringV(const FormattingContext& context,
                                   const scaled& height,
                                   const scaled& depth) const
 {
+  // the shapers cache the glyphs and assemblies making up the result
+  AreaArena::Scope heap(nullptr);
   return getShaperManager()->shapeStretchy(context, str, height + depth, 0);
 }
 
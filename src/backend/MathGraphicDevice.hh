@@ -27,6 +27,8 @@
 #include "String.hh"
 #include "GraphicDevice.hh"
 #include "MathFont.hh"
+#include "CachedShapedString.hh"
+#include "LRUCache.hh"
 
 class MathGraphicDevice : public GraphicDevice
 {
@@ -38,6 +40,9 @@ public:
   static SmartPtr<MathGraphicDevice> create(const hb_font_t* font);
 
   virtual void clearCache(void) const;
+  // limits apply to each of the two shaped string caches, 0 means unbounded
+  void setCacheLimits(size_t maxEntries, size_t maxBytes) const;
+  LRUCacheStats getCacheStats(void) const;
 
   // Length evaluation, fundamental properties
 
@@ -112,6 +117,17 @@ private:
   scaled getRuleThickness(const class FormattingContext&, MathConstant) const;
   SmartPtr<class MathFont> m_mathfont;
   const hb_font_t* m_font;
+  int m_upem;
+
+  typedef LRUCache<CachedShapedStringKey, AreaRef,
+                   CachedShapedStringKeyHash, CachedShapedStringCost> ShapedStringCache;
+  typedef LRUCache<CachedShapedStretchyStringKey, AreaRef,
+                   CachedShapedStretchyStringKeyHash, CachedShapedStringCost> ShapedStretchyStringCache;
+
+  static const size_t DEFAULT_CACHE_ENTRIES = 8192;
+
+  mutable ShapedStringCache stringCache;
+  mutable ShapedStretchyStringCache stretchyStringCache;
 };
 
 #endif // __MathGraphicDevice_hh__
@@ -23,89 +23,321 @@
 
 #include <config.h>
 #include <hb.h>
+#include <hb-ot.h>
 
+#include <algorithm>
 #include <vector>
 
+#include "AbstractLogger.hh"
 #include "Area.hh"
+#include "AreaArena.hh"
 #include "AreaFactory.hh"
+#include "Element.hh"
+#include "MathFontRegistry.hh"
 #include "MathShaper.hh"
 #include "ShapingContext.hh"
 
 MathShaper::MathShaper(const hb_font_t* font)
   : m_font(font)
+  , m_upem(hb_face_get_upem(hb_font_get_face(const_cast<hb_font_t*>(font))))
+  , m_buffer(hb_buffer_create())
+  , m_nominalAscii(!hasCharSubstitutions(hb_font_get_face(const_cast<hb_font_t*>(font))))
+  , useShapingCache(true)
+  , shapingCache(DEFAULT_CACHE_ENTRIES)
+  , assemblyCache(DEFAULT_CACHE_ENTRIES)
 {
-  m_mathfont = MathFont::create(font);
+  m_mathfont = MathFontRegistry::get(font);
 }
 
 MathShaper::~MathShaper()
-{ }
+{
+  hb_buffer_destroy(m_buffer);
+  m_mathfont = nullptr;
+  MathFontRegistry::purge();
+}
+
+// Whether the GSUB table of face has features that may replace a
+// single character out of scripts with other glyphs than its nominal
+// one: localized forms, glyph composition and decomposition, and
+// ligatures, which some fonts also use for single characters
+bool
+MathShaper::hasCharSubstitutions(hb_face_t* face)
+{
+  static const hb_tag_t substitutions[] = {
+    HB_TAG('l','o','c','l'),
+    HB_TAG('c','c','m','p'),
+    HB_TAG('l','i','g','a')
+  };
+
+  hb_tag_t tags[32];
+  unsigned offset = 0;
+  unsigned count;
+  do
+    {
+      count = sizeof(tags) / sizeof(tags[0]);
+      hb_ot_layout_table_get_feature_tags(face, HB_OT_TAG_GSUB, offset, &count, tags);
+      for (unsigned i = 0; i < count; i++)
+        if (std::find(substitutions, substitutions + 3, tags[i]) != substitutions + 3)
+          return true;
+      offset += count;
+    }
+  while (count == sizeof(tags) / sizeof(tags[0]));
+
+  return false;
+}
 
 void
-MathShaper::shape(ShapingContext& context) const
+MathShaper::shapeGlyphs(const UCS4String& source, int scriptLevel, std::vector<unsigned>& glyphs) const
 {
   hb_font_t* font = const_cast<hb_font_t*>(m_font);
-  hb_face_t* face = hb_font_get_face(font);
-  int upem = hb_face_get_upem(face);
 
-  UCS4String source = context.getSource();
-  hb_buffer_t* buffer = hb_buffer_create();
+  // a single ASCII character out of scripts, as most identifiers and
+  // numbers are, maps to its nominal glyph without shaping, unless the
+  // font may substitute it
+  hb_codepoint_t glyph;
+  if (m_nominalAscii && source.length() == 1 && source[0] < 0x80 && scriptLevel <= 0
+      && hb_font_get_nominal_glyph(font, source[0], &glyph))
+    {
+      glyphs.assign(1, glyph);
+      return;
+    }
 
-  hb_buffer_set_direction(buffer, HB_DIRECTION_LTR);
-  hb_buffer_set_script(buffer, hb_script_from_string("Math", -1));
-  hb_buffer_add_utf32(buffer, source.c_str(), source.length(), 0, source.length());
+  hb_buffer_clear_contents(m_buffer);
+  hb_buffer_set_direction(m_buffer, HB_DIRECTION_LTR);
+  hb_buffer_set_script(m_buffer, hb_script_from_string("Math", -1));
+  hb_buffer_add_utf32(m_buffer, source.c_str(), source.length(), 0, source.length());
 
-  int scriptLevel = context.getScriptLevel();
   if (scriptLevel > 0)
     {
       hb_feature_t features[] = {
         { HB_TAG('s','s','t','y'), (unsigned)scriptLevel, 0, (unsigned)-1 },
         { 0, 0, 0, 0 }
       };
-      hb_shape(font, buffer, features, 1);
+      hb_shape(font, m_buffer, features, 1);
     }
   else
     {
-      hb_shape(font, buffer, nullptr, 0);
+      hb_shape(font, m_buffer, nullptr, 0);
     }
 
-  unsigned len = hb_buffer_get_length(buffer);
-  hb_glyph_info_t* glyphs = hb_buffer_get_glyph_infos(buffer, nullptr);
+  unsigned len = hb_buffer_get_length(m_buffer);
+  hb_glyph_info_t* info = hb_buffer_get_glyph_infos(m_buffer, nullptr);
+
+  glyphs.resize(len);
+  for (unsigned i = 0; i < len; i++)
+    glyphs[i] = info[i].codepoint;
+}
+
+void
+MathShaper::shape(ShapingContext& context) const
+{
+  const UCS4String source = context.getSource();
+  const int scriptLevel = std::max(context.getScriptLevel(), 0);
+
+  std::vector<unsigned> glyphs;
+  if (useShapingCache)
+    {
+      const ShapingKey key(source, scriptLevel);
+      if (!shapingCache.find(key, glyphs))
+	{
+	  shapeGlyphs(source, scriptLevel, glyphs);
+	  shapingCache.insert(key, glyphs);
+	}
+    }
+  else
+    shapeGlyphs(source, scriptLevel, glyphs);
 
+  const unsigned len = glyphs.size();
   const SmartPtr<AreaFactory> factory = context.getFactory();
   std::vector<AreaRef> areaV;
+  bool warned = false;
 
   for (unsigned i = 0; i < len; i++)
     {
-      unsigned variantId, glyphId;
-
-      glyphId = glyphs[i].codepoint;
+      const unsigned glyphId = glyphs[i];
+      unsigned variantId = glyphId;
 
       AreaRef glyphArea = getGlyphArea(glyphId, context.getSize());
-      variantId = glyphId;
 
-      if (glyphArea->box().verticalExtent() < context.getVSpan())
+      // only a single glyph is stretched
+      if (len == 1 && glyphArea->box().verticalExtent() < context.getVSpan())
         {
-          assert(len == 1);
-          scaled span = (context.getVSpan() * upem).getValue() / context.getSize().getValue();
-          variantId = m_mathfont->getVariant(variantId, span, false);
+          scaled span = (context.getVSpan() * m_upem).getValue() / context.getSize().getValue();
+          variantId = stretchGlyph(variantId, span, false, factory, context.getSize(), glyphArea);
         }
 
-      if (glyphArea->box().horizontalExtent() < context.getHSpan())
+      if (len == 1 && glyphArea->box().horizontalExtent() < context.getHSpan())
         {
-          assert(len == 1);
-          scaled span = (context.getHSpan() * upem).getValue() / context.getSize().getValue();
-          variantId = m_mathfont->getVariant(variantId, span, true);
+          scaled span = (context.getHSpan() * m_upem).getValue() / context.getSize().getValue();
+          variantId = stretchGlyph(variantId, span, true, factory, context.getSize(), glyphArea);
         }
 
-      if (variantId != glyphId)
-        glyphArea = getGlyphArea(variantId, context.getSize());
+      if (len > 1 && !warned
+          && (glyphArea->box().verticalExtent() < context.getVSpan()
+              || glyphArea->box().horizontalExtent() < context.getHSpan()))
+        {
+          if (SmartPtr<Element> elem = context.getElement())
+            elem->getLogger()->out(LOG_WARNING, "cannot stretch a string shaped to %u glyphs", len);
+          warned = true;
+        }
 
       areaV.push_back(glyphArea);
     }
 
   context.pushArea(source.length(), factory->horizontalArray(areaV));
+}
+
+// Replaces area, the area of glyph, with the smallest variant of the
+// glyph covering span (in font units) in the given direction or, if no
+// variant is large enough, with the assembly of the glyph when it is
+// longer than the largest variant. Returns the glyph of the variant
+unsigned
+MathShaper::stretchGlyph(unsigned glyph, scaled span, bool horiz,
+                         const SmartPtr<AreaFactory>& factory,
+                         const scaled& size, AreaRef& area) const
+{
+  MathFont::GlyphConstruction construction;
+  if (!m_mathfont->getConstruction(glyph, horiz, construction))
+    return glyph;
+
+  const bool tooShort = construction.variantCount == 0
+    || int(construction.variants[construction.variantCount - 1].advance) < span.toInt();
+  AssemblyLayout layout;
+  if (tooShort && layoutAssembly(construction, m_mathfont->getMinConnectorOverlap(), span.toInt(), layout))
+    {
+      area = assembleGlyph(glyph, construction, layout, horiz, factory, size);
+      return glyph;
+    }
+
+  const unsigned variant = m_mathfont->getVariant(glyph, span, horiz);
+  if (variant != glyph)
+    area = getGlyphArea(variant, size);
+  return variant;
+}
+
+// The overlap between two adjacent parts, which must be at least the
+// minimum connector overlap of the font and at most the connectors of
+// the parts
+int
+MathShaper::partOverlap(const MathFont::GlyphPart& prev, const MathFont::GlyphPart& part,
+                        int minOverlap, int overlap)
+{
+  const int maxOverlap = std::min(prev.endConnectorLength, part.startConnectorLength);
+  return std::max(minOverlap, std::min(overlap, maxOverlap));
+}
+
+// Repeats the extenders as few times as possible for the assembly to
+// cover span and then spreads the excess length over the overlaps
+// between adjacent parts
+bool
+MathShaper::layoutAssembly(const MathFont::GlyphConstruction& construction, int minOverlap, unsigned span,
+                           AssemblyLayout& layout)
+{
+  int fixedAdvance = 0;
+  int extenderAdvance = 0;
+  unsigned fixedCount = 0;
+  unsigned extenderCount = 0;
+  for (unsigned i = 0; i < construction.partCount; i++)
+    if (construction.parts[i].extender)
+      {
+        extenderAdvance += construction.parts[i].fullAdvance;
+        extenderCount++;
+      }
+    else
+      {
+        fixedAdvance += construction.parts[i].fullAdvance;
+        fixedCount++;
+      }
+
+  // the longest assembly with the given number of repeats, when
+  // adjacent parts overlap by the minimum amount
+  auto maxLength = [&](unsigned repeats) {
+    const int count = fixedCount + repeats * extenderCount;
+    return fixedAdvance + int(repeats) * extenderAdvance - std::max(count - 1, 0) * minOverlap;
+  };
+
+  // extenders no longer than the overlaps they add cannot make the
+  // assembly any longer
+  static const unsigned MAX_REPEATS = 1000;
+  unsigned repeats = 0;
+  if (extenderCount > 0 && extenderAdvance > int(extenderCount) * minOverlap)
+    while (maxLength(repeats) < int(span) && repeats < MAX_REPEATS)
+      repeats++;
+
+  const unsigned count = fixedCount + repeats * extenderCount;
+  if (count == 0)
+    return false;
+
+  layout.repeats = repeats;
+  layout.overlap = (count > 1)
+    ? minOverlap + std::max(maxLength(repeats) - int(span), 0) / int(count - 1)
+    : 0;
+
+  // the overlaps are limited by the connectors, hence the length is
+  // computed part by part as the assembly is built
+  layout.length = 0;
+  const MathFont::GlyphPart* prev = nullptr;
+  for (unsigned i = 0; i < construction.partCount; i++)
+    {
+      const MathFont::GlyphPart& part = construction.parts[i];
+      const unsigned n = part.extender ? repeats : 1;
+      for (unsigned j = 0; j < n; j++)
+        {
+          if (prev) layout.length -= partOverlap(*prev, part, minOverlap, layout.overlap);
+          layout.length += part.fullAdvance;
+          prev = &part;
+        }
+    }
+
+  return construction.variantCount == 0
+    || layout.length > int(construction.variants[construction.variantCount - 1].advance);
+}
+
+// Builds the assembly of the parts of the construction of glyph as
+// laid out by layoutAssembly
+AreaRef
+MathShaper::assembleGlyph(unsigned glyph, const MathFont::GlyphConstruction& construction, const AssemblyLayout& layout,
+                          bool horiz, const SmartPtr<AreaFactory>& factory, const scaled& size) const
+{
+  const AssemblyKey key(glyph, horiz, size, layout.repeats, layout.overlap);
+  AreaRef res;
+  if (assemblyCache.find(key, res))
+    return res;
+
+  // the assembly is cached beyond the formatting pass
+  AreaArena::Scope heap(nullptr);
+  const int minOverlap = m_mathfont->getMinConnectorOverlap();
+
+  // parts are listed from the bottom or from the left
+  std::vector<AreaRef> content;
+  const MathFont::GlyphPart* prev = nullptr;
+  for (unsigned i = 0; i < construction.partCount; i++)
+    {
+      const MathFont::GlyphPart& part = construction.parts[i];
+      const unsigned n = part.extender ? layout.repeats : 1;
+      for (unsigned j = 0; j < n; j++)
+        {
+          if (prev)
+            {
+              const int o = partOverlap(*prev, part, minOverlap, layout.overlap);
+              const scaled s = (scaled(o) * size) / m_upem;
+              if (horiz)
+                content.push_back(factory->horizontalSpace(-s));
+              else
+                content.push_back(factory->verticalSpace(-s, scaled::zero()));
+            }
+          content.push_back(getGlyphArea(part.glyph, size));
+          prev = &part;
+        }
+    }
+
+  if (horiz)
+    res = factory->horizontalArray(content);
+  else
+    res = factory->verticalArray(content, 0);
 
-  hb_buffer_destroy(buffer);
+  assemblyCache.insert(key, res);
+  return res;
 }
 
 bool
@@ -26,9 +26,12 @@
 
 #include <hb.h>
 
+#include <vector>
+
 #include "Shaper.hh"
 #include "String.hh"
 #include "MathFont.hh"
+#include "LRUCache.hh"
 
 class MathShaper : public Shaper
 {
@@ -48,12 +51,120 @@ public:
   virtual bool computeCombiningCharOffsetsBelow(const AreaRef&, const AreaRef&,
                                                 scaled&) const;
 
+  // the glyphs HarfBuzz yields for a string only depend on the string
+  // and on the script level (through the ssty feature), they are
+  // cached so that the same token at different sizes or in different
+  // elements is shaped once
+  void setUseShapingCache(bool b) const { useShapingCache = b; }
+  void clearShapingCache(void) const { shapingCache.clear(); assemblyCache.clear(); }
+  LRUCacheStats getShapingCacheStats(void) const { return shapingCache.getStats(); }
+  // the glyphs of a string at the given script level, before they are
+  // stretched
+  void shapeGlyphs(const UCS4String&, int, std::vector<unsigned>&) const;
+
+  // how the assembly of a construction covers a span (in font units):
+  // the number of times every extender is repeated, the overlap aimed
+  // at between adjacent parts and the length of the assembly
+  struct AssemblyLayout
+  {
+    unsigned repeats;
+    int overlap;
+    int length;
+  };
+
+  // false if the construction has no assembly or if its assembly is no
+  // longer than its largest variant, which is then used instead
+  static bool layoutAssembly(const MathFont::GlyphConstruction&, int, unsigned, AssemblyLayout&);
+
 protected:
   virtual AreaRef getGlyphArea(unsigned, const scaled&) const = 0;
 
 private:
+  static bool hasCharSubstitutions(hb_face_t*);
+  unsigned stretchGlyph(unsigned, scaled, bool, const SmartPtr<class AreaFactory>&,
+                        const scaled&, AreaRef&) const;
+  AreaRef assembleGlyph(unsigned, const MathFont::GlyphConstruction&, const AssemblyLayout&, bool,
+                        const SmartPtr<class AreaFactory>&, const scaled&) const;
+  static int partOverlap(const MathFont::GlyphPart&, const MathFont::GlyphPart&, int, int);
+
+  struct ShapingKey
+  {
+    ShapingKey(const UCS4String& s, int l) : source(s), scriptLevel(l) { }
+
+    bool operator==(const ShapingKey& key) const
+    { return source == key.source && scriptLevel == key.scriptLevel; }
+
+    UCS4String source;
+    int scriptLevel;
+  };
+
+  struct ShapingKeyHash
+  {
+    size_t operator()(const ShapingKey& key) const
+    {
+      size_t hash = key.scriptLevel;
+      for (Char32 ch : key.source) hash = hash * 31 + ch;
+      return hash;
+    }
+  };
+
+  struct ShapingCost
+  {
+    size_t operator()(const ShapingKey& key, const std::vector<unsigned>& glyphs) const
+    { return sizeof(key) + key.source.capacity() * sizeof(Char32) + glyphs.capacity() * sizeof(unsigned) + 4 * sizeof(void*); }
+  };
+
+  typedef LRUCache<ShapingKey, std::vector<unsigned>, ShapingKeyHash, ShapingCost> ShapingCache;
+
+  // an assembly is determined by the glyph, the direction, the size,
+  // the number of times the extenders are repeated and the overlap
+  // between the parts, many spans yield the same assembly
+  struct AssemblyKey
+  {
+    AssemblyKey(unsigned g, bool h, const scaled& sz, unsigned r, int o)
+      : glyph(g), horizontal(h), size(sz), repeats(r), overlap(o) { }
+
+    bool operator==(const AssemblyKey& key) const
+    { return glyph == key.glyph && horizontal == key.horizontal && size == key.size
+        && repeats == key.repeats && overlap == key.overlap; }
+
+    unsigned glyph;
+    bool horizontal;
+    scaled size;
+    unsigned repeats;
+    int overlap;
+  };
+
+  struct AssemblyKeyHash
+  {
+    size_t operator()(const AssemblyKey& key) const
+    {
+      // the size and the overlap may be negative, shift them unsigned
+      return (size_t(key.glyph) << 1) ^ size_t(key.horizontal) ^ size_t(unsigned(key.size.getValue()))
+        ^ (size_t(key.repeats) << 16) ^ (size_t(unsigned(key.overlap)) << 8);
+    }
+  };
+
+  struct AssemblyCost
+  {
+    size_t operator()(const AssemblyKey& key, const AreaRef&) const
+    { return sizeof(key) + sizeof(AreaRef) + 4 * sizeof(void*); }
+  };
+
+  typedef LRUCache<AssemblyKey, AreaRef, AssemblyKeyHash, AssemblyCost> AssemblyCache;
+
+  static const size_t DEFAULT_CACHE_ENTRIES = 8192;
+
   SmartPtr<class MathFont> m_mathfont;
   const hb_font_t* m_font;
+  int m_upem;
+  // reused by every shaping, a shaper belongs to a single thread
+  hb_buffer_t* m_buffer;
+  // single ASCII characters map to their nominal glyphs
+  bool m_nominalAscii;
+  mutable bool useShapingCache;
+  mutable ShapingCache shapingCache;
+  mutable AssemblyCache assemblyCache;
 };
 
 #endif // __MathShaper_hh__
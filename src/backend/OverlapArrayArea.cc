@@ -24,6 +24,7 @@
 
 #include "AreaId.hh"
 #include "OverlapArrayArea.hh"
+#include "SpatialIndex.hh"
 
 AreaRef
 OverlapArrayArea::clone(const std::vector<AreaRef>& content) const
@@ -47,7 +48,8 @@ OverlapArrayArea::flattenAux(std::vector<AreaRef>& dest, const std::vector<AreaR
 AreaRef
 OverlapArrayArea::flatten(void) const
 {
-  std::vector<AreaRef> newContent(content.size());
+  std::vector<AreaRef> newContent;
+  newContent.reserve(content.size());
   flattenAux(newContent, content);
   if (newContent != content)
     return clone(newContent);
@@ -107,6 +109,17 @@ OverlapArrayArea::searchByCoords(AreaId& id, const scaled& x, const scaled& y) c
   return false;
 }
 
+void
+OverlapArrayArea::indexByCoords(SpatialIndex& index, const scaled& x, const scaled& y) const
+{
+  for (auto p = content.rbegin(); p != content.rend(); p++)
+    {
+      index.push(content.size() - (p - content.rbegin()) - 1, *p, scaled::zero(), scaled::zero());
+      (*p)->indexByCoords(index, x, y);
+      index.pop();
+    }
+}
+
 void
 OverlapArrayArea::origin(AreaIndex i, struct Point&) const
 {
@@ -28,10 +28,12 @@
 class OverlapArrayArea : public LinearContainerArea
 {
 protected:
-  OverlapArrayArea(const std::vector<AreaRef>& children) : LinearContainerArea(children) { }
+  OverlapArrayArea(const std::vector<AreaRef>& children) : LinearContainerArea(children, KOverlapArrayArea) { initEdges(); }
   virtual ~OverlapArrayArea() { }
 
 public:
+  DECLARE_KIND(OverlapArrayArea, Area, KOverlapArrayArea, KOverlapArrayArea)
+
   static SmartPtr<OverlapArrayArea> create(const std::vector<AreaRef>& children) { return new OverlapArrayArea(children); }
   virtual AreaRef clone(const std::vector<AreaRef>&) const;
   virtual AreaRef flatten(void) const;
@@ -42,6 +44,7 @@ public:
   virtual void origin(AreaIndex, struct Point&) const;
 
   virtual bool searchByCoords(class AreaId&, const scaled&, const scaled&) const;
+  virtual void indexByCoords(class SpatialIndex&, const scaled&, const scaled&) const;
 
 private:
   static void flattenAux(std::vector<AreaRef>&, const std::vector<AreaRef>&);  
@@ -23,7 +23,9 @@
 #ifndef __RenderingContext_hh__
 #define __RenderingContext_hh__
 
+#include "KindCast.hh"
 #include "RGBColor.hh"
+#include "Rectangle.hh"
 
 class RenderingContext
 {
@@ -32,10 +34,14 @@ protected:
 
 public:
   enum ColorStyle { NORMAL_STYLE, SELECTED_STYLE, MAX_STYLE };
+  // the backend the context renders to, see KindCast.hh
+  enum Kind { KRenderingContext, KCairoRenderingContext, KQtRenderingContext };
 
-  RenderingContext(void) : style(NORMAL_STYLE) { }
+  RenderingContext(Kind k = KRenderingContext) : kind(k), style(NORMAL_STYLE), clipped(false) { }
   virtual ~RenderingContext() { }
 
+  Kind getKind(void) const { return kind; }
+
   void setForegroundColor(const RGBColor& c) { data[getStyle()].setColor(FOREGROUND_INDEX, c); }
   void setBackgroundColor(const RGBColor& c) { data[getStyle()].setColor(BACKGROUND_INDEX, c); }
 
@@ -45,7 +51,24 @@ public:
   void setStyle(ColorStyle s) { style = s; }
   ColorStyle getStyle(void) const { return style; }
 
+  // when a clip rectangle is set, containers skip the children whose
+  // box does not intersect it. The rectangle is in the same coordinate
+  // system as the positions passed to Area::render. Glyph ink may
+  // overhang the box (slanted glyphs, accents), so the test is made
+  // against the rectangle widened by the given margin
+  void setClipRectangle(const Rectangle& r, const scaled& margin = scaled())
+  {
+    clip = Rectangle(r.x - margin, r.y - margin, r.width + margin * 2, r.height + margin * 2);
+    clipped = true;
+  }
+  void resetClipRectangle(void) { clipped = false; }
+  bool hasClipRectangle(void) const { return clipped; }
+  bool visible(const scaled& x, const scaled& y, const BoundingBox& box) const
+  { return !clipped || !box.defined() || clip.overlaps(Rectangle(x, y, box)); }
+
   virtual void fill(const scaled&, const scaled&, const BoundingBox&) const = 0;
+  // contexts that defer drawing operations must complete them here
+  virtual void flush(void) const { }
 
 private:
   struct ContextData
@@ -59,8 +82,11 @@ private:
     { return color[index]; }
   };
 
+  const Kind kind;
   ColorStyle style;
   ContextData data[MAX_STYLE];
+  bool clipped;
+  Rectangle clip;
 };
 
 #endif // __RenderingContext_hh__
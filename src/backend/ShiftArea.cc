@@ -23,6 +23,7 @@
 #include <config.h>
 
 #include "ShiftArea.hh"
+#include "SpatialIndex.hh"
 #include "AreaId.hh"
 #include "Point.hh"
 
@@ -51,6 +52,14 @@ ShiftArea::searchByCoords(AreaId& id, const scaled& x, const scaled& y) const
   return false;
 }
 
+void
+ShiftArea::indexByCoords(SpatialIndex& index, const scaled& x, const scaled& y) const
+{
+  index.push(0, getChild(), scaled::zero(), shift);
+  getChild()->indexByCoords(index, x, y + shift);
+  index.pop();
+}
+
 void
 ShiftArea::origin(AreaIndex i, Point& p) const
 {
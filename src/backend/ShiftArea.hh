@@ -40,6 +40,7 @@ public:
   virtual void origin(AreaIndex, struct Point&) const;
 
   virtual bool searchByCoords(class AreaId&, const scaled&, const scaled&) const;
+  virtual void indexByCoords(class SpatialIndex&, const scaled&, const scaled&) const;
 
   scaled getShift(void) const { return shift; }
 
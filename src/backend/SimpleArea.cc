@@ -26,6 +26,7 @@
 
 #include "AreaId.hh"
 #include "SimpleArea.hh"
+#include "SpatialIndex.hh"
 #include "Rectangle.hh"
 
 AreaRef
@@ -50,6 +51,10 @@ bool
 SimpleArea::searchByCoords(AreaId&, const scaled& x, const scaled& y) const
 { return Rectangle(scaled::zero(), scaled::zero(), box()).isInside(x, y); }
 
+void
+SimpleArea::indexByCoords(SpatialIndex& index, const scaled& x, const scaled& y) const
+{ index.add(x, y, box()); }
+
 bool
 SimpleArea::searchByIndex(AreaId&, CharIndex index) const
 { return false; }
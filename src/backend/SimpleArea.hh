@@ -28,7 +28,7 @@
 class SimpleArea : public Area
 {
 protected:
-  SimpleArea(void) { }
+  SimpleArea(Kind k = KArea) : Area(k) { }
   virtual ~SimpleArea() { }
 
 public:
@@ -42,6 +42,7 @@ public:
 
   virtual bool searchByArea(class AreaId&, const AreaRef&) const;
   virtual bool searchByCoords(class AreaId&, const scaled&, const scaled&) const;
+  virtual void indexByCoords(class SpatialIndex&, const scaled&, const scaled&) const;
   virtual bool searchByIndex(class AreaId&, CharIndex) const;
 };
 
@@ -0,0 +1,197 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <config.h>
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+
+#include "SpatialIndex.hh"
+#include "AreaId.hh"
+
+// maximum number of entries in a leaf of the hierarchy
+#define LEAF_SIZE 8
+
+static bool
+intersect(const Rectangle& r1, const Rectangle& r2, Rectangle& res)
+{
+  // rectangles are closed, so touching rectangles do intersect
+  const scaled x0 = std::max(r1.x, r2.x);
+  const scaled y0 = std::max(r1.y, r2.y);
+  const scaled x1 = std::min(r1.x + r1.width, r2.x + r2.width);
+  const scaled y1 = std::min(r1.y + r1.height, r2.y + r2.height);
+  if (x1 < x0 || y1 < y0) return false;
+  res = Rectangle(x0, y0, x1 - x0, y1 - y0);
+  return true;
+}
+
+SpatialIndex::SpatialIndex(const AreaRef& r)
+  : root(r), current(-1)
+{
+  assert(root);
+  root->indexByCoords(*this, scaled::zero(), scaled::zero());
+  assert(current == -1);
+  assert(clip.empty());
+  if (!entries.empty()) build(0, entries.size());
+}
+
+SpatialIndex::~SpatialIndex()
+{ }
+
+void
+SpatialIndex::push(AreaIndex index, const AreaRef& area, const scaled& dx, const scaled& dy)
+{
+  PathNode node;
+  node.parent = current;
+  node.index = index;
+  node.area = area;
+  node.origin = Point(dx, dy);
+  path.push_back(node);
+  current = path.size() - 1;
+}
+
+void
+SpatialIndex::pop()
+{
+  assert(current >= 0);
+  current = path[current].parent;
+}
+
+void
+SpatialIndex::pushClip(const scaled& x, const scaled& y, const BoundingBox& box)
+{
+  Rectangle rect(x, y, box);
+  if (!clip.empty() && !intersect(clip.back(), rect, rect))
+    rect = Rectangle(x, y, -scaled::one(), -scaled::one()); // empty
+  clip.push_back(rect);
+}
+
+void
+SpatialIndex::popClip()
+{
+  assert(!clip.empty());
+  clip.pop_back();
+}
+
+void
+SpatialIndex::add(const scaled& x, const scaled& y, const BoundingBox& box)
+{
+  if (!box.defined()) return;
+
+  Entry entry;
+  entry.rect = Rectangle(x, y, box);
+  if (!clip.empty() && !intersect(clip.back(), entry.rect, entry.rect)) return;
+  entry.node = current;
+  // entries are added in search order, earlier ones take precedence
+  entry.rank = entries.size();
+  entries.push_back(entry);
+}
+
+int
+SpatialIndex::build(unsigned begin, unsigned end)
+{
+  assert(begin < end);
+
+  TreeNode node;
+  node.bounds = entries[begin].rect;
+  node.minRank = entries[begin].rank;
+  for (unsigned i = begin + 1; i < end; i++)
+    {
+      node.bounds.merge(entries[i].rect);
+      node.minRank = std::min(node.minRank, entries[i].rank);
+    }
+  node.begin = begin;
+  node.end = end;
+  node.left = node.right = -1;
+
+  const int n = tree.size();
+  tree.push_back(node);
+
+  if (end - begin > LEAF_SIZE)
+    {
+      // split the entries along the longest side of the bounds
+      const bool horizontal = node.bounds.width >= node.bounds.height;
+      const unsigned mid = begin + (end - begin) / 2;
+      std::nth_element(entries.begin() + begin, entries.begin() + mid, entries.begin() + end,
+		       [horizontal](const Entry& e1, const Entry& e2)
+		       {
+			 return horizontal
+			   ? e1.rect.x + e1.rect.width / 2 < e2.rect.x + e2.rect.width / 2
+			   : e1.rect.y + e1.rect.height / 2 < e2.rect.y + e2.rect.height / 2;
+		       });
+      const int left = build(begin, mid);
+      const int right = build(mid, end);
+      tree[n].left = left;
+      tree[n].right = right;
+    }
+
+  return n;
+}
+
+bool
+SpatialIndex::searchByCoords(AreaId& id, const scaled& x, const scaled& y) const
+{
+  if (tree.empty()) return false;
+
+  // look for the entry with the lowest rank containing the point,
+  // that is the area the recursive search would have stopped at
+  const Entry* best = nullptr;
+  unsigned bestRank = UINT_MAX;
+  std::vector<int> stack;
+  stack.push_back(0);
+  while (!stack.empty())
+    {
+      const TreeNode& node = tree[stack.back()];
+      stack.pop_back();
+      if (node.minRank >= bestRank || !node.bounds.isInside(x, y)) continue;
+
+      if (node.left < 0)
+	{
+	  for (unsigned i = node.begin; i < node.end; i++)
+	    if (entries[i].rank < bestRank && entries[i].rect.isInside(x, y))
+	      {
+		best = &entries[i];
+		bestRank = best->rank;
+	      }
+	}
+      else if (tree[node.left].minRank < tree[node.right].minRank)
+	{
+	  // visit the most promising child first
+	  stack.push_back(node.right);
+	  stack.push_back(node.left);
+	}
+      else
+	{
+	  stack.push_back(node.left);
+	  stack.push_back(node.right);
+	}
+    }
+
+  if (!best) return false;
+
+  std::vector<int> nodes;
+  for (int n = best->node; n >= 0; n = path[n].parent)
+    nodes.push_back(n);
+  for (auto p = nodes.rbegin(); p != nodes.rend(); p++)
+    id.append(path[*p].index, path[*p].area, path[*p].origin.x, path[*p].origin.y);
+
+  return true;
+}
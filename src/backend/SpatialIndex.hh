@@ -0,0 +1,93 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __SpatialIndex_hh__
+#define __SpatialIndex_hh__
+
+#include <vector>
+
+#include "Area.hh"
+#include "Point.hh"
+#include "Rectangle.hh"
+
+// A SpatialIndex answers Area::searchByCoords queries on a root area
+// in logarithmic time. The areas that can terminate a search are
+// collected once, in search order, by Area::indexByCoords along with
+// their rectangle in root coordinates, and are then arranged into a
+// bounding volume hierarchy. Since areas are immutable, an index
+// remains valid for as long as its root area is the one being queried
+
+class SpatialIndex : public Object
+{
+protected:
+  SpatialIndex(const AreaRef&);
+  virtual ~SpatialIndex();
+
+public:
+  static SmartPtr<SpatialIndex> create(const AreaRef& root) { return new SpatialIndex(root); }
+
+  AreaRef getRootArea(void) const { return root; }
+  unsigned getEntryCount(void) const { return entries.size(); }
+  bool searchByCoords(class AreaId&, const scaled&, const scaled&) const;
+
+  // used by Area::indexByCoords implementations while building the index
+  void push(AreaIndex, const AreaRef&, const scaled&, const scaled&);
+  void pop(void);
+  void pushClip(const scaled&, const scaled&, const BoundingBox&);
+  void popClip(void);
+  void add(const scaled&, const scaled&, const BoundingBox&);
+
+private:
+  struct PathNode
+  {
+    int parent;
+    AreaIndex index;
+    AreaRef area;
+    Point origin;
+  };
+
+  struct Entry
+  {
+    Rectangle rect;
+    int node;
+    unsigned rank;
+  };
+
+  struct TreeNode
+  {
+    Rectangle bounds;
+    unsigned minRank;
+    unsigned begin;
+    unsigned end;
+    int left;
+    int right;
+  };
+
+  int build(unsigned, unsigned);
+
+  const AreaRef root;
+  int current;
+  std::vector<PathNode> path;
+  std::vector<Rectangle> clip;
+  std::vector<Entry> entries;
+  std::vector<TreeNode> tree;
+};
+
+#endif // __SpatialIndex_hh__
@@ -26,13 +26,49 @@
 
 #include "AreaId.hh"
 #include "Point.hh"
+#include "RenderingContext.hh"
 #include "VerticalArrayArea.hh"
+#include "SpatialIndex.hh"
 
 VerticalArrayArea::VerticalArrayArea(const std::vector<AreaRef>& children, AreaIndex r)
-  : LinearContainerArea(children), refArea(r)
+  : LinearContainerArea(children, KVerticalArrayArea), refArea(r)
 {
   assert(content.size() > 0);
   assert(refArea >= 0 && refArea < content.size());
+
+  initEdges();
+
+  cachedBox = content[refArea]->box();
+  scaled depth = 0;
+  for (auto p = content.begin(); p != content.end(); p++)
+    {
+      const AreaIndex i = p - content.begin();
+      const BoundingBox pbox = (*p)->box();
+      if (i < refArea)
+	cachedBox.over(pbox);
+      else if (i > refArea)
+	cachedBox.under(pbox);
+
+      if (pbox)
+	{
+	  if (i < refArea)
+	    depth += pbox.verticalExtent();
+	  else if (i == refArea)
+	    depth += pbox.depth;
+	}
+    }
+
+  // the children are stacked from the bottom up, starting depth
+  // below the baseline of the reference child
+  childOffset.reserve(content.size());
+  scaled y = -depth;
+  for (const auto & elem : content)
+    {
+      const BoundingBox pbox = elem->box();
+      if (pbox) y += pbox.depth;
+      childOffset.push_back(y);
+      if (pbox) y += pbox.height;
+    }
 }
 
 // unsigned
@@ -62,62 +98,17 @@ VerticalArrayArea::flatten(void) const
     return this;
 }
 
-BoundingBox
-VerticalArrayArea::box() const
-{
-  BoundingBox bbox = content[refArea]->box();
-  for (auto p = content.begin();
-       p != content.end();
-       p++)
-    {
-      const AreaIndex i = p - content.begin();
-      if (i < refArea)
-	bbox.over((*p)->box());
-      else if (i > refArea)
-	bbox.under((*p)->box());
-    }
-  return bbox;
-}
-
-scaled
-VerticalArrayArea::prepareChildBoxes(std::vector<BoundingBox>& box) const
-{
-  box.reserve(content.size());
-  scaled depth = 0;
-  for (auto p = content.begin();
-       p != content.end();
-       p++)
-    {
-      const AreaIndex i = p - content.begin();
-      box.push_back((*p)->box());
-      if (BoundingBox backBox = box.back())
-        {
-	if (i < refArea)
-	  depth += backBox.verticalExtent();
-	else if (i == refArea)
-	  depth += backBox.depth;
-        }
-    }
-
-  return depth;
-}
-
 void
 VerticalArrayArea::render(class RenderingContext& context, const scaled& x, const scaled& y0) const
 {
-  std::vector<BoundingBox> box;
-  scaled depth = prepareChildBoxes(box);
-
-  scaled y = y0 - depth;
   for (auto p = content.begin();
        p != content.end();
        p++)
     {
-      const AreaIndex i = p - content.begin();
-      if (box[i]) y += box[i].depth;
-      (*p)->render(context, x, y);
-      if (box[i]) y += box[i].height;
-    }  
+      const scaled y = y0 + childOffset[p - content.begin()];
+      if (context.visible(x, y, (*p)->box()))
+        (*p)->render(context, x, y);
+    }
 }
 
 void
@@ -196,25 +187,33 @@ VerticalArrayArea::fit(const scaled& width, const scaled& height, const scaled&
 bool
 VerticalArrayArea::searchByCoords(AreaId& id, const scaled& x, const scaled& y) const
 {
-  std::vector<BoundingBox> box;
-  scaled depth = prepareChildBoxes(box);
-
-  scaled offset = -depth;
   for (auto p = content.begin();
        p != content.end();
        p++)
     {
       const AreaIndex i = p - content.begin();
-      offset += box[i].depth;
-      id.append(i, *p, scaled::zero(), offset);
-      if ((*p)->searchByCoords(id, x, y - offset)) return true;
+      id.append(i, *p, scaled::zero(), childOffset[i]);
+      if ((*p)->searchByCoords(id, x, y - childOffset[i])) return true;
       id.pop_back();
-      offset += box[i].height;
-    }  
+    }
 
   return false;
 }
 
+void
+VerticalArrayArea::indexByCoords(SpatialIndex& index, const scaled& x, const scaled& y) const
+{
+  for (auto p = content.begin();
+       p != content.end();
+       p++)
+    {
+      const AreaIndex i = p - content.begin();
+      index.push(i, *p, scaled::zero(), childOffset[i]);
+      (*p)->indexByCoords(index, x, y + childOffset[i]);
+      index.pop();
+    }
+}
+
 bool
 VerticalArrayArea::searchByIndex(AreaId& id, CharIndex index) const
 {
@@ -232,40 +231,13 @@ void
 VerticalArrayArea::origin(AreaIndex i, Point& point) const
 {
   assert(i >= 0 && i < content.size());
-  if (i < refArea)
-    {
-      if (BoundingBox idBox = content[i]->box())
-	point.y -= idBox.height;
-      if (BoundingBox refBox = content[refArea]->box())
-	point.y -= refBox.depth;
-      for (auto p = content.begin() + i + 1;
-	   p != content.begin() + refArea;
-	   p++)
-	if (BoundingBox b = (*p)->box())
-	  point.y -= b.verticalExtent();
-    }
-  else if (i > refArea)
-    {
-      if (BoundingBox refBox = content[refArea]->box())
-	point.y += refBox.height;
-      if (BoundingBox idBox = content[i]->box())
-	point.y += idBox.depth;
-      for (auto p = content.begin() + refArea + 1;
-	   p != content.begin() + i;
-	   p++)
-	if (BoundingBox b = (*p)->box())
-	  point.y += b.verticalExtent();
-    }
+  point.y += childOffset[i];
 }
 
 CharIndex
 VerticalArrayArea::lengthTo(AreaIndex i) const
 {
   assert(i >= 0 && i < content.size());
-  CharIndex length = 0;
-  for (auto p = content.rbegin();
-       p != content.rbegin() + i;
-       p++)
-    length += (*p)->length();
-  return length;
+  // characters are counted from the last child
+  return lengthPrefix[content.size()] - lengthPrefix[content.size() - i];
 }
@@ -32,6 +32,8 @@ protected:
   virtual ~VerticalArrayArea() { }
 
 public:
+  DECLARE_KIND(VerticalArrayArea, Area, KVerticalArrayArea, KVerticalArrayArea)
+
   static SmartPtr<VerticalArrayArea> create(const std::vector<AreaRef>& children, AreaIndex ref = 0)
   { return new VerticalArrayArea(children, ref); }
   virtual AreaRef clone(const std::vector<AreaRef>& children) const
@@ -39,7 +41,7 @@ public:
 
   virtual AreaRef flatten(void) const;
 
-  virtual BoundingBox box(void) const;
+  virtual BoundingBox box(void) const { return cachedBox; }
   virtual void render(class RenderingContext&, const scaled&, const scaled&) const;
   virtual void strength(int&, int&, int&) const;
   virtual AreaRef fit(const scaled&, const scaled&, const scaled&) const;
@@ -49,15 +51,15 @@ public:
   AreaIndex getRefArea(void) const { return refArea; }
 
   virtual bool searchByCoords(class AreaId&, const scaled&, const scaled&) const;
+  virtual void indexByCoords(class SpatialIndex&, const scaled&, const scaled&) const;
   virtual bool searchByIndex(class AreaId&, CharIndex) const;
 
-protected:
-  scaled prepareChildBoxes(std::vector<BoundingBox>&) const;
-
 private:
   //static void flattenAux(std::vector<AreaRef>&, const std::vector<AreaRef>&, unsigned);
 
   AreaIndex refArea;
+  BoundingBox cachedBox;
+  std::vector<scaled> childOffset; // vertical origin of each child
 };
 
 #endif // __VerticalArrayArea_hh__
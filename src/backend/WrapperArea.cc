@@ -28,7 +28,7 @@
 #include "WrapperArea.hh"
 
 WrapperArea::WrapperArea(const AreaRef& area, const BoundingBox& b, const SmartPtr<Element>& el)
-  : BoxArea(area, b), element(el),  selected(0)
+  : BoxArea(area, b, KWrapperArea), element(el),  selected(0)
 { }
 
 WrapperArea::~WrapperArea()
@@ -33,6 +33,8 @@ protected:
   virtual ~WrapperArea();
 
 public:
+  DECLARE_KIND(WrapperArea, Area, KWrapperArea, KWrapperArea)
+
   static SmartPtr<WrapperArea> create(const AreaRef&, const BoundingBox&, const SmartPtr<class Element>&);
   virtual AreaRef clone(const AreaRef&) const;
 
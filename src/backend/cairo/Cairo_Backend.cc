@@ -30,12 +30,14 @@
 
 #include "AreaFactory.hh"
 #include "Cairo_Backend.hh"
+#include "Cairo_FontCache.hh"
 #include "Cairo_Shaper.hh"
 #include "MathGraphicDevice.hh"
 #include "ShaperManager.hh"
 #include "SpaceShaper.hh"
 
 Cairo_Backend::Cairo_Backend(cairo_scaled_font_t* font)
+  : fontCache(Cairo_FontCache::create())
 {
   SmartPtr<AreaFactory> factory = AreaFactory::create();
 
@@ -49,7 +51,8 @@ Cairo_Backend::Cairo_Backend(cairo_scaled_font_t* font)
   mgd->setFactory(factory);
   setMathGraphicDevice(mgd);
 
-  getShaperManager()->registerShaper(Cairo_Shaper::create(font, hb_font));
+  shaper = Cairo_Shaper::create(font, hb_font, fontCache);
+  getShaperManager()->registerShaper(shaper);
   getShaperManager()->registerShaper(SpaceShaper::create());
 }
 
@@ -59,3 +62,19 @@ Cairo_Backend::~Cairo_Backend()
 SmartPtr<Cairo_Backend>
 Cairo_Backend::create(cairo_scaled_font_t* font)
 { return new Cairo_Backend(font); }
+
+SmartPtr<Cairo_FontCache>
+Cairo_Backend::getFontCache() const
+{ return fontCache; }
+
+SmartPtr<MathShaper>
+Cairo_Backend::getMathShaper() const
+{ return shaper; }
+
+void
+Cairo_Backend::clearCache() const
+{
+  Backend::clearCache();
+  shaper->clearShapingCache();
+  fontCache->clear();
+}
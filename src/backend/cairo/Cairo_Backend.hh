@@ -33,6 +33,14 @@ protected:
 
 public:
   static SmartPtr<Cairo_Backend> create(cairo_scaled_font_t* f);
+
+  SmartPtr<class Cairo_FontCache> getFontCache(void) const;
+  SmartPtr<class MathShaper> getMathShaper(void) const;
+  virtual void clearCache(void) const;
+
+private:
+  SmartPtr<class Cairo_FontCache> fontCache;
+  SmartPtr<class Cairo_Shaper> shaper;
 };
 
 #endif // __Cairo_Backend_hh__
@@ -0,0 +1,94 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <config.h>
+
+#include "AreaArena.hh"
+#include "Cairo_FontCache.hh"
+#include "Cairo_GlyphArea.hh"
+
+Cairo_FontCache::Cairo_FontCache(const cairo_font_options_t* options)
+  : fontOptions(options ? cairo_font_options_copy(options) : cairo_font_options_create())
+  , fontCache(DEFAULT_FONT_ENTRIES)
+  , glyphCache(DEFAULT_GLYPH_ENTRIES)
+{ }
+
+Cairo_FontCache::~Cairo_FontCache()
+{
+  clear();
+  cairo_font_options_destroy(fontOptions);
+}
+
+cairo_scaled_font_t*
+Cairo_FontCache::getScaledFont(cairo_font_face_t* face, const scaled& size) const
+{
+  const FontKey key(face, size);
+  ScaledFont font;
+  if (fontCache.find(key, font))
+    {
+      stats.fontHits++;
+      return font.get();
+    }
+
+  stats.fontMisses++;
+
+  cairo_matrix_t matrix, ctm;
+  cairo_matrix_init_scale(&matrix, size.toDouble(), size.toDouble());
+  cairo_matrix_init_identity(&ctm);
+  font = ScaledFont(cairo_scaled_font_create(face, &matrix, &ctm, fontOptions));
+  fontCache.insert(key, font);
+  return font.get();
+}
+
+AreaRef
+Cairo_FontCache::getGlyphArea(cairo_scaled_font_t* font, unsigned glyph) const
+{
+  const GlyphKey key(font, glyph);
+  AreaRef area;
+  if (glyphCache.find(key, area))
+    {
+      stats.glyphHits++;
+      return area;
+    }
+
+  stats.glyphMisses++;
+  {
+    // the glyph is cached beyond the formatting pass
+    AreaArena::Scope heap(nullptr);
+    area = Cairo_GlyphArea::create(font, glyph);
+  }
+  glyphCache.insert(key, area);
+  return area;
+}
+
+void
+Cairo_FontCache::clear() const
+{
+  // the glyph areas hold references to the fonts
+  glyphCache.clear();
+  fontCache.clear();
+}
+
+void
+Cairo_FontCache::setLimits(size_t maxFonts, size_t maxGlyphs) const
+{
+  glyphCache.setLimits(maxGlyphs, 0);
+  fontCache.setLimits(maxFonts, 0);
+}
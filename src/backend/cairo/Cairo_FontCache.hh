@@ -0,0 +1,149 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __Cairo_FontCache_hh__
+#define __Cairo_FontCache_hh__
+
+#include <cairo.h>
+
+#include <cstddef>
+
+#include "Area.hh"
+#include "LRUCache.hh"
+#include "Object.hh"
+#include "SmartPtr.hh"
+#include "scaled.hh"
+
+// Cairo_FontCache keeps one cairo_scaled_font_t per (face, size) pair
+// and one glyph area per (scaled font, glyph) pair, so that shaping a
+// glyph that has already been seen at the same size costs a hash lookup
+// instead of a font instantiation and an extents query. All the fonts
+// are created with the font options given at construction time. Both
+// caches evict their least recently used entries beyond a number of
+// entries; an evicted font is released once the glyph areas created
+// from it are gone, so its address cannot be reused by a font that
+// would hit the glyphs of the evicted one.
+
+class Cairo_FontCache : public Object
+{
+protected:
+  Cairo_FontCache(const cairo_font_options_t*);
+  virtual ~Cairo_FontCache();
+
+public:
+  static SmartPtr<Cairo_FontCache> create(const cairo_font_options_t* options = nullptr)
+  { return new Cairo_FontCache(options); }
+
+  // the font is owned by the cache and valid until the next call
+  cairo_scaled_font_t* getScaledFont(cairo_font_face_t*, const scaled&) const;
+  AreaRef getGlyphArea(cairo_scaled_font_t*, unsigned) const;
+  void clear(void) const;
+  void setLimits(size_t maxFonts, size_t maxGlyphs) const;
+
+  struct Stats
+  {
+    Stats(void) : fontHits(0), fontMisses(0), glyphHits(0), glyphMisses(0) { }
+
+    unsigned long fontHits;
+    unsigned long fontMisses;
+    unsigned long glyphHits;
+    unsigned long glyphMisses;
+  };
+
+  Stats getStats(void) const { return stats; }
+  void resetStats(void) const { stats = Stats(); }
+  size_t getFontCount(void) const { return fontCache.getStats().entries; }
+  size_t getGlyphCount(void) const { return glyphCache.getStats().entries; }
+
+private:
+  struct FontKey
+  {
+    FontKey(cairo_font_face_t* f, const scaled& sz) : face(f), size(sz) { }
+
+    bool operator==(const FontKey& key) const
+    { return face == key.face && size == key.size; }
+
+    cairo_font_face_t* face;
+    scaled size;
+  };
+
+  struct GlyphKey
+  {
+    GlyphKey(cairo_scaled_font_t* f, unsigned g) : font(f), glyph(g) { }
+
+    bool operator==(const GlyphKey& key) const
+    { return font == key.font && glyph == key.glyph; }
+
+    cairo_scaled_font_t* font;
+    unsigned glyph;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(const FontKey& key) const
+    { return std::hash<void*>()(key.face) ^ key.size.getValue(); }
+    size_t operator()(const GlyphKey& key) const
+    { return std::hash<void*>()(key.font) ^ key.glyph; }
+  };
+
+  // holds a reference to a scaled font, so that the fonts evicted from
+  // the cache are destroyed
+  class ScaledFont
+  {
+  public:
+    explicit ScaledFont(cairo_scaled_font_t* f = nullptr) : font(f) { }
+    ScaledFont(const ScaledFont& f) : font(cairo_scaled_font_reference(f.font)) { }
+    ~ScaledFont() { cairo_scaled_font_destroy(font); }
+
+    ScaledFont& operator=(const ScaledFont& f)
+    {
+      cairo_scaled_font_t* old = font;
+      font = cairo_scaled_font_reference(f.font);
+      cairo_scaled_font_destroy(old);
+      return *this;
+    }
+
+    cairo_scaled_font_t* get(void) const { return font; }
+
+  private:
+    cairo_scaled_font_t* font;
+  };
+
+  struct KeyCost
+  {
+    size_t operator()(const FontKey& key, const ScaledFont&) const
+    { return sizeof(key) + sizeof(ScaledFont) + 4 * sizeof(void*); }
+    size_t operator()(const GlyphKey& key, const AreaRef&) const
+    { return sizeof(key) + sizeof(AreaRef) + 4 * sizeof(void*); }
+  };
+
+  typedef LRUCache<FontKey, ScaledFont, KeyHash, KeyCost> FontCache;
+  typedef LRUCache<GlyphKey, AreaRef, KeyHash, KeyCost> GlyphCache;
+
+  static const size_t DEFAULT_FONT_ENTRIES = 64;
+  static const size_t DEFAULT_GLYPH_ENTRIES = 4096;
+
+  cairo_font_options_t* fontOptions;
+  mutable FontCache fontCache;
+  mutable GlyphCache glyphCache;
+  mutable Stats stats;
+};
+
+#endif // __Cairo_FontCache_hh__
@@ -29,7 +29,7 @@
 #include "Cairo_RenderingContext.hh"
 
 Cairo_GlyphArea::Cairo_GlyphArea(cairo_scaled_font_t* f, unsigned g)
-  : m_font(f), m_glyph(g)
+  : m_font(cairo_scaled_font_reference(f)), m_glyph(g)
 {
   cairo_glyph_t glyphs[1] = { { m_glyph, 0, 0 } };
   cairo_text_extents_t extents;
@@ -49,6 +49,6 @@ Cairo_GlyphArea::~Cairo_GlyphArea()
 void
 Cairo_GlyphArea::render(RenderingContext& c, const scaled& x, const scaled& y) const
 {
-  Cairo_RenderingContext& context = dynamic_cast<Cairo_RenderingContext&>(c);
+  Cairo_RenderingContext& context = checked_cast<Cairo_RenderingContext>(c);
   context.draw(x, y, m_font, m_glyph);
 }
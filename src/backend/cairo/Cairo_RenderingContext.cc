@@ -28,17 +28,20 @@
 #include "Cairo_RenderingContext.hh"
 
 Cairo_RenderingContext::Cairo_RenderingContext(cairo_t* cr)
-  : m_cr(cr)
+  : RenderingContext(KCairoRenderingContext), m_cr(cr), m_runFont(nullptr)
 { }
 
 Cairo_RenderingContext::~Cairo_RenderingContext()
 {
+  flush();
   cairo_destroy(m_cr);
 }
 
 void
 Cairo_RenderingContext::fill(const scaled& x, const scaled& y, const BoundingBox& box) const
 {
+  flush();
+
   cairo_save(m_cr);
 
   RGBColor fg = getForegroundColor();
@@ -53,14 +56,32 @@ void
 Cairo_RenderingContext::draw(const scaled& x, const scaled& y, cairo_scaled_font_t* font,
                              unsigned glyph) const
 {
-  cairo_save(m_cr);
-
   RGBColor fg = getForegroundColor();
-  cairo_set_scaled_font(m_cr, font);
-  cairo_set_source_rgba(m_cr, fg.red / 255., fg.green / 255., fg.blue / 255., fg.alpha / 255.);
+  if (font != m_runFont || fg != m_runColor)
+    {
+      flush();
+      m_runFont = cairo_scaled_font_reference(font);
+      m_runColor = fg;
+    }
+
+  cairo_glyph_t g = { glyph, x.toDouble(), -y.toDouble() };
+  m_run.push_back(g);
+}
 
-  cairo_glyph_t glyphs[1] = { { glyph, x.toDouble(), -y.toDouble() } };
-  cairo_show_glyphs(m_cr, glyphs, 1);
+void
+Cairo_RenderingContext::flush() const
+{
+  if (m_run.empty()) return;
+
+  cairo_save(m_cr);
+
+  cairo_set_scaled_font(m_cr, m_runFont);
+  cairo_set_source_rgba(m_cr, m_runColor.red / 255., m_runColor.green / 255., m_runColor.blue / 255., m_runColor.alpha / 255.);
+  cairo_show_glyphs(m_cr, m_run.data(), m_run.size());
 
   cairo_restore(m_cr);
+
+  m_run.clear();
+  cairo_scaled_font_destroy(m_runFont);
+  m_runFont = nullptr;
 }
@@ -26,6 +26,8 @@
 
 #include <cairo/cairo.h>
 
+#include <vector>
+
 #include "SmartPtr.hh"
 #include "Rectangle.hh"
 #include "RenderingContext.hh"
@@ -33,14 +35,22 @@
 class Cairo_RenderingContext : public RenderingContext
 {
 public:
+  DECLARE_KIND(Cairo_RenderingContext, RenderingContext, KCairoRenderingContext, KCairoRenderingContext)
+
   Cairo_RenderingContext(cairo_t* cr);
   virtual ~Cairo_RenderingContext();
 
   void fill(const scaled&, const scaled&, const BoundingBox&) const;
   void draw(const scaled&, const scaled&, cairo_scaled_font_t*, unsigned) const;
+  virtual void flush(void) const;
 
 private:
+  // consecutive glyphs with the same font and color are accumulated
+  // in a run and shown with a single cairo_show_glyphs call
   cairo_t* m_cr;
+  mutable cairo_scaled_font_t* m_runFont;
+  mutable RGBColor m_runColor;
+  mutable std::vector<cairo_glyph_t> m_run;
 };
 
 #endif // __Cairo_RenderingContext_hh__
@@ -23,32 +23,25 @@
 
 #include <config.h>
 
-#include "Cairo_GlyphArea.hh"
-#include "Cairo_RenderingContext.hh"
+#include "Cairo_FontCache.hh"
 #include "Cairo_Shaper.hh"
 #include "MathGraphicDevice.hh"
 #include "ShapingContext.hh"
 
 Cairo_Shaper::Cairo_Shaper(const cairo_scaled_font_t* font,
-                           const hb_font_t* hb_font)
+                           const hb_font_t* hb_font,
+                           const SmartPtr<Cairo_FontCache>& cache)
   : MathShaper(hb_font)
   , m_font(font)
+  , m_cache(cache)
 { }
 
 Cairo_Shaper::~Cairo_Shaper()
 { }
 
 AreaRef
-Cairo_Shaper::getGlyphArea(unsigned glyph, const scaled& sp_size) const
+Cairo_Shaper::getGlyphArea(unsigned glyph, const scaled& size) const
 {
-  double size = sp_size.toDouble();
   cairo_font_face_t* face = cairo_scaled_font_get_font_face(const_cast<cairo_scaled_font_t*>(m_font));
-  cairo_matrix_t matrix, ctm;
-  cairo_matrix_init_scale (&matrix, size, size);
-  cairo_matrix_init_identity (&ctm);
-  cairo_font_options_t* options = cairo_font_options_create();
-  cairo_scaled_font_t* font = cairo_scaled_font_create(face, &matrix, &ctm, options);
-  cairo_font_options_destroy(options);
-
-  return Cairo_GlyphArea::create(font, glyph);
+  return m_cache->getGlyphArea(m_cache->getScaledFont(face, size), glyph);
 }
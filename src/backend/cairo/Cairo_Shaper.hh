@@ -31,12 +31,13 @@
 class Cairo_Shaper : public MathShaper
 {
 protected:
-  Cairo_Shaper(const cairo_scaled_font_t*, const hb_font_t*);
+  Cairo_Shaper(const cairo_scaled_font_t*, const hb_font_t*, const SmartPtr<class Cairo_FontCache>&);
   virtual ~Cairo_Shaper();
 
 public:
-  static SmartPtr<Cairo_Shaper> create(const cairo_scaled_font_t* font, const hb_font_t* hb_font)
-  { return new Cairo_Shaper(font, hb_font); }
+  static SmartPtr<Cairo_Shaper> create(const cairo_scaled_font_t* font, const hb_font_t* hb_font,
+                                       const SmartPtr<class Cairo_FontCache>& cache)
+  { return new Cairo_Shaper(font, hb_font, cache); }
 
   virtual bool isDefaultShaper(void) const { return true; }
 
@@ -45,6 +46,7 @@ protected:
 
 private:
   const cairo_scaled_font_t* m_font;
+  SmartPtr<class Cairo_FontCache> m_cache;
 };
 
 #endif // __Cairo_Shaper_hh__
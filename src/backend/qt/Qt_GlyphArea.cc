@@ -71,6 +71,6 @@ Qt_GlyphArea::rightEdge() const
 void
 Qt_GlyphArea::render(RenderingContext& c, const scaled& x, const scaled& y) const
 {
-    Qt_RenderingContext& context = dynamic_cast<Qt_RenderingContext&>(c);
+    Qt_RenderingContext& context = checked_cast<Qt_RenderingContext>(c);
     context.draw(x, y, m_glyphRun);
 }
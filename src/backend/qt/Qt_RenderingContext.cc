@@ -32,6 +32,7 @@
 #include "Qt_RenderingContext.hh"
 
 Qt_RenderingContext::Qt_RenderingContext(void)
+    : RenderingContext(KQtRenderingContext)
 { }
 
 Qt_RenderingContext::~Qt_RenderingContext()
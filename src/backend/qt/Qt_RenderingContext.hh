@@ -35,6 +35,8 @@ class QGlyphRun;
 class Qt_RenderingContext : public RenderingContext
 {
 public:
+    DECLARE_KIND(Qt_RenderingContext, RenderingContext, KQtRenderingContext, KQtRenderingContext)
+
     Qt_RenderingContext();
     virtual ~Qt_RenderingContext();
 
@@ -0,0 +1,87 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __KindCast_hh__
+#define __KindCast_hh__
+
+#include <cassert>
+#include <type_traits>
+
+// Nodes, areas, values and rendering contexts store in their base
+// class a kind identifying the most derived class of the object. The
+// kinds of a class and of its subclasses form a contiguous range, so
+// a class declaring it with DECLARE_KIND can be tested for with two
+// comparisons instead of a dynamic_cast. Classes that do not declare
+// their own kind range fall back to dynamic_cast.
+
+#define DECLARE_KIND(Class, Base, first, last)				\
+  typedef Class KindClass;						\
+  static bool classof(const Base* p)					\
+  { return p->getKind() >= Base::first && p->getKind() <= Base::last; }
+
+namespace KindCastAux
+{
+  // the typedef is inherited by subclasses, they are tested with
+  // classof only if they declare their own kind range
+  template <class Q, class R>
+  inline auto
+  isa(const R* p, int)
+    -> typename std::enable_if<std::is_same<typename Q::KindClass, Q>::value, decltype(Q::classof(p))>::type
+  { return Q::classof(p); }
+
+  template <class Q, class R>
+  inline bool
+  isa(const R* p, long)
+  { return dynamic_cast<const Q*>(p) != nullptr; }
+
+  template <class Q, class R>
+  inline auto
+  cast(R* p, int)
+    -> typename std::enable_if<std::is_same<typename std::remove_const<Q>::type::KindClass,
+					    typename std::remove_const<Q>::type>::value,
+			       decltype(std::remove_const<Q>::type::classof(p), static_cast<Q*>(p))>::type
+  { return (p && std::remove_const<Q>::type::classof(p)) ? static_cast<Q*>(p) : nullptr; }
+
+  template <class Q, class R>
+  inline Q*
+  cast(R* p, long)
+  { return dynamic_cast<Q*>(p); }
+}
+
+template <class Q, class R>
+inline bool
+kind_isa(const R* p)
+{ return p && KindCastAux::isa<typename std::remove_const<Q>::type>(p, 0); }
+
+template <class Q, class R>
+inline Q*
+kind_cast(R* p)
+{ return KindCastAux::cast<Q>(p, 0); }
+
+// downcast of a reference that is known to be of the right kind
+template <class Q, class R>
+inline Q&
+checked_cast(R& r)
+{
+  assert(Q::classof(&r));
+  return static_cast<Q&>(r);
+}
+
+#endif // __KindCast_hh__
@@ -0,0 +1,144 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __LRUCache_hh__
+#define __LRUCache_hh__
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+struct LRUCacheStats
+{
+  LRUCacheStats(void) : hits(0), misses(0), evictions(0), entries(0), bytes(0) { }
+
+  LRUCacheStats& operator+=(const LRUCacheStats& s)
+  {
+    hits += s.hits;
+    misses += s.misses;
+    evictions += s.evictions;
+    entries += s.entries;
+    bytes += s.bytes;
+    return *this;
+  }
+
+  unsigned long hits;
+  unsigned long misses;
+  unsigned long evictions;
+  size_t entries;
+  size_t bytes;
+};
+
+// A hash map with least-recently-used eviction. The cache is bounded
+// by a number of entries and by a number of bytes, as estimated by the
+// Cost functor on each (key, value) pair; a limit of 0 means unbounded.
+
+template <class K, class V, class Hash, class Cost>
+class LRUCache
+{
+public:
+  LRUCache(size_t maxE = 0, size_t maxB = 0) : maxEntries(maxE), maxBytes(maxB) { }
+
+  void setLimits(size_t maxE, size_t maxB)
+  {
+    maxEntries = maxE;
+    maxBytes = maxB;
+    shrink();
+  }
+
+  size_t getMaxEntries(void) const { return maxEntries; }
+  size_t getMaxBytes(void) const { return maxBytes; }
+
+  bool find(const K& key, V& value)
+  {
+    typename Map::iterator p = map.find(key);
+    if (p == map.end())
+      {
+        stats.misses++;
+        return false;
+      }
+
+    stats.hits++;
+    items.splice(items.begin(), items, p->second);
+    value = p->second->second;
+    return true;
+  }
+
+  void insert(const K& key, const V& value)
+  {
+    typename Map::iterator p = map.find(key);
+    if (p != map.end())
+      {
+        stats.bytes -= Cost()(p->second->first, p->second->second);
+        p->second->second = value;
+        stats.bytes += Cost()(p->second->first, p->second->second);
+        items.splice(items.begin(), items, p->second);
+      }
+    else
+      {
+        items.push_front(std::make_pair(key, value));
+        map.insert(std::make_pair(key, items.begin()));
+        stats.entries++;
+        stats.bytes += Cost()(key, value);
+      }
+    shrink();
+  }
+
+  void clear(void)
+  {
+    map.clear();
+    items.clear();
+    stats.entries = 0;
+    stats.bytes = 0;
+  }
+
+  const LRUCacheStats& getStats(void) const { return stats; }
+  void resetStats(void)
+  {
+    stats.hits = stats.misses = stats.evictions = 0;
+  }
+
+private:
+  void shrink(void)
+  {
+    while (!items.empty()
+           && ((maxEntries && stats.entries > maxEntries) || (maxBytes && stats.bytes > maxBytes)))
+      {
+        const std::pair<K, V>& last = items.back();
+        stats.bytes -= Cost()(last.first, last.second);
+        stats.entries--;
+        stats.evictions++;
+        map.erase(last.first);
+        items.pop_back();
+      }
+  }
+
+  typedef std::list<std::pair<K, V> > List;
+  typedef std::unordered_map<K, typename List::iterator, Hash> Map;
+
+  size_t maxEntries;
+  size_t maxBytes;
+  List items;
+  Map map;
+  LRUCacheStats stats;
+};
+
+#endif // __LRUCache_hh__
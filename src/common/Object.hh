@@ -23,6 +23,50 @@
 #ifndef __Object_hh__
 #define __Object_hh__
 
+#include <atomic>
+
+// By default reference counting is atomic, so immutable objects (an
+// operator dictionary, parsed attribute values, ...) can be shared by
+// several threads. Mutable objects, such as views and elements, must
+// not be used by more than one thread at a time. Single-threaded
+// programs can avoid the cost of atomic operations by building the
+// library and themselves with MATHVIEW_PLAIN_REFCOUNT defined
+// (configure --disable-atomic-refcount)
+
+class AtomicRefCount
+{
+public:
+  AtomicRefCount(void) : counter(0) { }
+
+  void ref(void) { counter.fetch_add(1, std::memory_order_relaxed); }
+  // the release/acquire pair makes all the writes done to the object
+  // by other threads visible to the thread that deletes it
+  bool unref(void) { return counter.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+  unsigned count(void) const { return counter.load(std::memory_order_acquire); }
+
+private:
+  std::atomic<unsigned> counter;
+};
+
+class PlainRefCount
+{
+public:
+  PlainRefCount(void) : counter(0) { }
+
+  void ref(void) { counter++; }
+  bool unref(void) { return --counter == 0; }
+  unsigned count(void) const { return counter; }
+
+private:
+  unsigned counter;
+};
+
+#ifdef MATHVIEW_PLAIN_REFCOUNT
+typedef PlainRefCount RefCountPolicy;
+#else
+typedef AtomicRefCount RefCountPolicy;
+#endif
+
 class Object
 {
 protected:
@@ -30,7 +74,7 @@ protected:
   // to create directly instances of this class. We want to be sure
   // that all the instances are created dynamically, because of the
   // memory management
-  Object(void) : refCounter(0) { }
+  Object(void) { }
 
   // Having a protected destructor makes it impossible for users
   // to call delete on an object of this class. Thus they are
@@ -38,11 +82,14 @@ protected:
   virtual ~Object() { }
 
 public:
-  void ref(void) const { refCounter++; }
-  void unref(void) const { if (--refCounter == 0) delete this; }
+  void ref(void) const { refCounter.ref(); }
+  void unref(void) const { if (refCounter.unref()) delete this; }
+  // only meaningful when no other thread can create or drop references
+  // to the object at the same time
+  unsigned getRefCount(void) const { return refCounter.count(); }
 
 private:
-  mutable unsigned refCounter;
+  mutable RefCountPolicy refCounter;
 };
 
 #endif // __Object_hh__
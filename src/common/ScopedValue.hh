@@ -0,0 +1,80 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __ScopedValue_hh__
+#define __ScopedValue_hh__
+
+#include <vector>
+
+// A ScopedValue is a value that can be rebound in nested scopes and
+// recovers its previous binding when the scope is left. The previous
+// bindings of all the values of type T live in one ScopedValueLog<T>,
+// which is a stack with no allocation once it has grown to the
+// maximum nesting depth
+
+template <typename T>
+struct ScopedValue
+{
+  ScopedValue(void) : value(), scope(0) { }
+
+  T value;
+  unsigned scope; // the scope in which value was bound
+};
+
+template <typename T>
+class ScopedValueLog
+{
+public:
+  ScopedValueLog(unsigned capacity = 64) { entries.reserve(capacity); }
+
+  void set(ScopedValue<T>& v, const T& value, unsigned scope)
+  {
+    if (v.scope != scope)
+      {
+	entries.push_back(Entry(&v, scope));
+	v.scope = scope;
+      }
+    v.value = value;
+  }
+
+  // restores the values that were rebound in scope
+  void undo(unsigned scope)
+  {
+    while (!entries.empty() && entries.back().scope == scope)
+      {
+	*entries.back().target = entries.back().saved;
+	entries.pop_back();
+      }
+  }
+
+private:
+  struct Entry
+  {
+    Entry(ScopedValue<T>* t, unsigned s) : target(t), saved(*t), scope(s) { }
+
+    ScopedValue<T>* target;
+    ScopedValue<T> saved;
+    unsigned scope;
+  };
+
+  std::vector<Entry> entries;
+};
+
+#endif // __ScopedValue_hh__
@@ -25,12 +25,17 @@
 
 #include <cassert>
 
+#include "KindCast.hh"
+
 template <class P>
 class SmartPtr
 {
 public:
   SmartPtr(P* p = 0) : ptr(p) { if (ptr) ptr->ref(); }
   SmartPtr(const SmartPtr& p) : ptr(p.ptr) { if (ptr) ptr->ref(); }
+  // moving transfers the reference, so returning smart pointers and
+  // growing vectors of them do not touch the reference counters
+  SmartPtr(SmartPtr&& p) noexcept : ptr(p.ptr) { p.ptr = 0; }
   ~SmartPtr() { if (ptr) ptr->unref(); }
 
   P* operator->() const { assert(ptr); return ptr; }
@@ -42,6 +47,15 @@ public:
     ptr = p.ptr;
     return *this;
   }
+  SmartPtr& operator=(SmartPtr&& p) noexcept
+  {
+    if (this == &p) return *this;
+    P* old = ptr;
+    ptr = p.ptr;
+    p.ptr = 0;
+    if (old) old->unref();
+    return *this;
+  }
 
   operator P*() const { return ptr; }
   template <class Q, class R> friend SmartPtr<Q> smart_cast(const SmartPtr<R>&);
@@ -55,11 +69,11 @@ private:
 template <class Q, class P>
 SmartPtr<Q>
 smart_cast(const SmartPtr<P>& p)
-{ return SmartPtr<Q>(dynamic_cast<Q*>(p.ptr)); }  
+{ return SmartPtr<Q>(kind_cast<Q>(p.ptr)); }
 
 template <class Q, class R>
 bool
 is_a(const SmartPtr<R>& p)
-{ return dynamic_cast<Q*>(p.ptr) != nullptr; }
+{ return kind_isa<Q>(p.ptr); }
 
 #endif // __SmartPtr_hh__
@@ -27,12 +27,34 @@
 
 class Value : public Object
 {
+public:
+  // the kinds of the variants used for attribute values, see
+  // Variant.hh and KindCast.hh
+  enum Kind
+    {
+      KValue,
+      KVoid,
+      KBool,
+      KInt,
+      KFloat,
+      KString,
+      KLength,
+      KRGBColor,
+      KTokenId,
+      KSequence
+    };
+
 protected:
-  Value(void) { }
+  Value(Kind k = KValue) : kind(k) { }
   virtual ~Value() { };
 
 public:
   class TypeError { };
+
+  Kind getKind(void) const { return kind; }
+
+private:
+  const Kind kind;
 };
 
 #endif // __Value_hh__
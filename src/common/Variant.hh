@@ -26,16 +26,36 @@
 #include <vector>
 
 #include "SmartPtr.hh"
+#include "String.hh"
 #include "Value.hh"
+#include "token.hh"
+
+template <typename T> struct VariantKind { static const Value::Kind kind = Value::KValue; };
+template <> struct VariantKind<bool> { static const Value::Kind kind = Value::KBool; };
+template <> struct VariantKind<int> { static const Value::Kind kind = Value::KInt; };
+template <> struct VariantKind<float> { static const Value::Kind kind = Value::KFloat; };
+template <> struct VariantKind<String> { static const Value::Kind kind = Value::KString; };
+template <> struct VariantKind<struct Length> { static const Value::Kind kind = Value::KLength; };
+template <> struct VariantKind<struct RGBColor> { static const Value::Kind kind = Value::KRGBColor; };
+template <> struct VariantKind<TokenId> { static const Value::Kind kind = Value::KTokenId; };
 
 template <typename T>
 class Variant : public Value
 {
 protected:
-  Variant(const T& v) : value(v) { }
+  Variant(const T& v) : Value(VariantKind<T>::kind), value(v) { }
   virtual ~Variant() { }
 
 public:
+  // variants of types without a kind of their own are told apart
+  // with a dynamic_cast
+  typedef Variant KindClass;
+  static bool classof(const Value* v)
+  {
+    if (VariantKind<T>::kind != KValue) return v->getKind() == VariantKind<T>::kind;
+    return dynamic_cast<const Variant*>(v) != nullptr;
+  }
+
   static SmartPtr<Variant> create(const T& v) { return new Variant(v); }
   T getValue(void) const { return value; }
 
@@ -47,10 +67,12 @@ template <>
 class Variant<void> : public Value
 {
 protected:
-  Variant(void) { }
+  Variant(void) : Value(KVoid) { }
   virtual ~Variant() { }
 
 public:
+  DECLARE_KIND(Variant, Value, KVoid, KVoid)
+
   static SmartPtr< Variant<void> > create(void)
   { return new Variant(); }
 };
@@ -62,10 +84,12 @@ template <>
 class Variant< std::vector< SmartPtr<Value> > > : public Value
 {
 protected:
-  Variant(const std::vector< SmartPtr<Value> >& v) : content(v) { }
+  Variant(const std::vector< SmartPtr<Value> >& v) : Value(KSequence), content(v) { }
   virtual ~Variant() { }
 
 public:
+  DECLARE_KIND(Variant, Value, KSequence, KSequence)
+
   static SmartPtr< Variant< std::vector< SmartPtr<Value> > > > create(const std::vector< SmartPtr<Value> >& v)
   { return new Variant(v); }
   const std::vector< SmartPtr<Value> >& getValue(void) const { return content; }
@@ -82,7 +106,7 @@ template <typename T>
 /* */ T
 as(const Value* v)
 {
-  if (const Variant<T>* obj = dynamic_cast<const Variant<T>*>(v))
+  if (const Variant<T>* obj = kind_cast<const Variant<T> >(v))
     return obj->getValue();
   else
     throw Value::TypeError();
@@ -25,6 +25,8 @@
 
 #include <cassert>
 
+#include "KindCast.hh"
+
 template <class P>
 class WeakPtr
 {
@@ -41,7 +43,7 @@ public:
   }
 
   operator P*() const { return ptr; }
-  template <class Q> friend WeakPtr<Q> weak_cast(const WeakPtr& p) { return WeakPtr<Q>(dynamic_cast<Q*>(p.ptr)); }  
+  template <class Q> friend WeakPtr<Q> weak_cast(const WeakPtr& p) { return WeakPtr<Q>(kind_cast<Q>(p.ptr)); }
   template <class Q> operator WeakPtr<Q>() const { return WeakPtr<Q>(ptr); }
 
 private:
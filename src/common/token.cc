@@ -41,7 +41,15 @@ static Entry token[] =
   };
 
 typedef std::unordered_map<String,TokenId,StringHash,StringEq> Map;
-static Map map;
+
+static Map
+createMap()
+{
+  Map map;
+  for (unsigned i = 1; token[i].literal; i++)
+    map[String(token[i].literal)] = token[i].id;
+  return map;
+}
 
 TokenId
 tokenIdOfString(const char* s)
@@ -53,13 +61,8 @@ tokenIdOfString(const char* s)
 TokenId
 tokenIdOfString(const String& s)
 {
-  static bool initialized = false;
-  if (!initialized)
-    {
-      for (unsigned i = 1; token[i].literal; i++)
-	map[String(token[i].literal)] = token[i].id;
-      initialized = true;
-    }
+  // initialization of local statics is thread-safe
+  static const Map map = createMap();
 
   auto p = map.find(s);
   return (p != map.end()) ? (*p).second : T__NOTVALID;
@@ -53,5 +53,7 @@ Attribute::getValue() const
 bool
 Attribute::equal(const SmartPtr<Attribute>& attribute) const
 {
-  return attribute->signature.name == signature.name && attribute->value == value;
+  // the value is parsed lazily, two attributes are equal if they
+  // have the same signature and the same unparsed value
+  return &attribute->signature == &signature && attribute->unparsedValue == unparsedValue;
 }
@@ -40,7 +40,7 @@ public:
   { return new Attribute(sig, value); }
 
   const struct AttributeSignature& getSignature(void) const { return signature; }
-  String getUnparsedValue(void) const { return unparsedValue; }
+  const String& getUnparsedValue(void) const { return unparsedValue; }
   SmartPtr<Value> getValue(void) const;
   bool equal(const SmartPtr<Attribute>&) const;
 
@@ -22,85 +22,167 @@
 
 #include <config.h>
 
-#include <functional>
 #include <algorithm>
+#include <functional>
 
 #include <cassert>
 
 #include "AttributeSet.hh"
 #include "AttributeSignature.hh"
 
-struct IsPredicate
-  : public std::binary_function<SmartPtr<Attribute>,AttributeId,bool>
-{
-  bool operator()(const SmartPtr<Attribute>& attr, const AttributeId& id) const
-  {
-    assert(attr);
-    return ATTRIBUTE_ID_OF_SIGNATURE(attr->getSignature()) == id;
-  }
-};
-
 AttributeSet::AttributeSet()
+  : entries(inlineEntries), size(0), capacity(INLINE_CAPACITY), shared(0)
 { }
 
+AttributeSet::AttributeSet(const AttributeSet& set)
+  : Object(), entries(inlineEntries), size(0), capacity(INLINE_CAPACITY), shared(0)
+{
+  if (set.size > INLINE_CAPACITY)
+    {
+      heapEntries.reset(new Entry[set.size]);
+      entries = heapEntries.get();
+      capacity = set.size;
+    }
+  std::copy(set.begin(), set.end(), entries);
+  size = set.size;
+}
+
 AttributeSet::~AttributeSet()
 { }
 
+const AttributeSet::Entry*
+AttributeSet::find(const AttributeId& id) const
+{
+  const Entry* p = std::lower_bound(begin(), end(), id,
+				    [](const Entry& entry, const AttributeId& id) { return entry.id < id; });
+  return (p != end() && p->id == id) ? p : end();
+}
+
+AttributeSet::Entry*
+AttributeSet::lowerBound(const AttributeId& id)
+{
+  return std::lower_bound(begin(), end(), id,
+			  [](const Entry& entry, const AttributeId& id) { return entry.id < id; });
+}
+
+void
+AttributeSet::grow()
+{
+  const unsigned newCapacity = 2 * capacity;
+  std::unique_ptr<Entry[]> newEntries(new Entry[newCapacity]);
+  std::move(begin(), end(), newEntries.get());
+  heapEntries = std::move(newEntries);
+  entries = heapEntries.get();
+  capacity = newCapacity;
+}
+
 bool
 AttributeSet::set(const SmartPtr<Attribute>& attr)
 {
   assert(attr);
-#if 1
-  // this version should be slightly more efficient
-  // see Scott Meyers' book on effective STL
-  auto lb = content.lower_bound(ATTRIBUTE_ID_OF_SIGNATURE(attr->getSignature()));
-  if (lb != content.end() && !(content.key_comp()(ATTRIBUTE_ID_OF_SIGNATURE(attr->getSignature()), lb->first)))
+  assert(!shared);
+  const AttributeId id = ATTRIBUTE_ID_OF_SIGNATURE(attr->getSignature());
+  Entry* p = lowerBound(id);
+  if (p != end() && p->id == id)
     {
-      if (!attr->equal(lb->second))
-	{
-	  lb->second = attr;
-	  return true;
-	}
-      else
+      if (attr->equal(p->attribute))
 	return false;
-    }
-  else
-    {
-      content.insert(lb, Map::value_type(ATTRIBUTE_ID_OF_SIGNATURE(attr->getSignature()), attr));
+      p->attribute = attr;
       return true;
     }
-#else
-  Map::iterator p = content.find(ATTRIBUTE_ID_OF_SIGNATURE(attr->getSignature()));
-  if (p != content.end())
+
+  if (size == capacity)
     {
-      bool eq = attr->equal(p->second);
-      p->second = attr;
-      return !eq;
+      const unsigned offset = p - begin();
+      grow();
+      p = begin() + offset;
     }
-  else
-    {
-      content[ATTRIBUTE_ID_OF_SIGNATURE(attr->getSignature())] = attr;
-      return true;
-    }
-#endif
+
+  std::move_backward(p, end(), end() + 1);
+  p->id = id;
+  p->attribute = attr;
+  size++;
+  return true;
 }
 
 SmartPtr<Attribute>
 AttributeSet::get(const AttributeId& id) const
 {
-  auto p = content.find(id);
-  return (p != content.end()) ? p->second : nullptr;
+  const Entry* p = find(id);
+  return (p != end()) ? p->attribute : nullptr;
 }
 
 bool
 AttributeSet::remove(const AttributeId& id)
 {
-  auto p = content.find(id);
-  if (p != content.end())
+  assert(!shared);
+  Entry* p = lowerBound(id);
+  if (p != end() && p->id == id)
     {
-      content.erase(p);
+      std::move(p + 1, end(), p);
+      size--;
+      end()->attribute = nullptr;
       return true;
     }
   else
     return false;
 }
+
+size_t
+AttributeSet::hash() const
+{
+  size_t h = size;
+  for (const Entry* p = begin(); p != end(); p++)
+    {
+      h = h * 31 + std::hash<const void*>()(p->id);
+      h = h * 31 + std::hash<String>()(p->attribute->getUnparsedValue());
+    }
+  return h;
+}
+
+bool
+AttributeSet::equal(const AttributeSet& set) const
+{
+  if (size != set.size) return false;
+  for (const Entry* p = begin(), * q = set.begin(); p != end(); p++, q++)
+    if (p->id != q->id || !p->attribute->equal(q->attribute))
+      return false;
+  return true;
+}
+
+SmartPtr<AttributeSet>
+AttributeSetPool::share(const SmartPtr<AttributeSet>& set)
+{
+  assert(set);
+  if (set->isShared()) return set;
+
+  Pool::const_iterator p = pool.find(set);
+  if (p != pool.end())
+    {
+      stats.hits++;
+      return *p;
+    }
+
+  stats.misses++;
+  if (pool.size() >= purgeSize)
+    {
+      // the sets referenced only by the pool are garbage, dropping
+      // them when the pool has doubled keeps the cost amortized
+      purge();
+      purgeSize = std::max<size_t>(MIN_PURGE_SIZE, 2 * pool.size());
+    }
+
+  set->shared = 1;
+  pool.insert(set);
+  return set;
+}
+
+void
+AttributeSetPool::purge()
+{
+  for (Pool::iterator p = pool.begin(); p != pool.end(); )
+    if ((*p)->getRefCount() == 1)
+      p = pool.erase(p);
+    else
+      p++;
+}
@@ -23,27 +23,110 @@
 #ifndef __AttributeSet_hh__
 #define __AttributeSet_hh__
 
-#include <map>
+#include <memory>
+#include <unordered_set>
 
 #include "Attribute.hh"
 
+// AttributeSet keeps the attributes sorted by signature in a flat
+// array. Most elements have one to three attributes, these fit in the
+// storage inside the set and no further allocation is needed. A set
+// obtained from an AttributeSetPool may be referenced by many elements
+// and must not be modified, it has to be cloned first
+
 class AttributeSet : public Object
 {
 protected:
   AttributeSet(void);
+  AttributeSet(const AttributeSet&);
   ~AttributeSet();
 
 public:
   static SmartPtr<AttributeSet> create(void)
   { return new AttributeSet(); }
+  SmartPtr<AttributeSet> clone(void) const
+  { return new AttributeSet(*this); }
 
   bool set(const SmartPtr<Attribute>&);
   bool remove(const AttributeId&);
   SmartPtr<Attribute> get(const AttributeId&) const;
+  bool has(const AttributeId& id) const { return find(id) != end(); }
+  unsigned getSize(void) const { return size; }
+  bool isShared(void) const { return shared; }
+
+  size_t hash(void) const;
+  bool equal(const AttributeSet&) const;
 
 private:
-  typedef std::map<AttributeId, SmartPtr<Attribute> > Map;
-  Map content;
+  struct Entry
+  {
+    AttributeId id;
+    SmartPtr<Attribute> attribute;
+  };
+
+  Entry* begin(void) { return entries; }
+  Entry* end(void) { return entries + size; }
+  const Entry* begin(void) const { return entries; }
+  const Entry* end(void) const { return entries + size; }
+  const Entry* find(const AttributeId&) const;
+  Entry* lowerBound(const AttributeId&);
+  void grow(void);
+
+  enum { INLINE_CAPACITY = 3 };
+
+  Entry* entries;
+  unsigned size;
+  unsigned capacity : 31;
+  unsigned shared : 1;
+  Entry inlineEntries[INLINE_CAPACITY];
+  std::unique_ptr<Entry[]> heapEntries;
+
+  friend class AttributeSetPool;
+};
+
+// AttributeSetPool hands out one set for every distinct content, so
+// that elements with the same attributes share their set. A pool is
+// not thread safe, each builder has its own
+class AttributeSetPool
+{
+public:
+  AttributeSetPool(void) : purgeSize(MIN_PURGE_SIZE) { }
+
+  SmartPtr<AttributeSet> share(const SmartPtr<AttributeSet>&);
+  // drops the sets that are no longer referenced by any element
+  void purge(void);
+
+  struct Stats
+  {
+    Stats(void) : hits(0), misses(0) { }
+
+    unsigned long hits;
+    unsigned long misses;
+  };
+
+  Stats getStats(void) const { return stats; }
+  void resetStats(void) { stats = Stats(); }
+  size_t getSetCount(void) const { return pool.size(); }
+
+private:
+  struct SetHash
+  {
+    size_t operator()(const SmartPtr<AttributeSet>& set) const
+    { return set->hash(); }
+  };
+
+  struct SetEq
+  {
+    bool operator()(const SmartPtr<AttributeSet>& set1, const SmartPtr<AttributeSet>& set2) const
+    { return set1->equal(*set2); }
+  };
+
+  enum { MIN_PURGE_SIZE = 256 };
+
+  typedef std::unordered_set<SmartPtr<AttributeSet>, SetHash, SetEq> Pool;
+  Pool pool;
+  size_t purgeSize;
+  Stats stats;
 };
 
 #endif // __AttributeSet_hh__
@@ -22,15 +22,27 @@
 
 #include <config.h>
 
+#include <atomic>
 #include <cassert>
 
 #include "AttributeSignature.hh"
 
+// beyond this size a table stops growing, so that documents with
+// many distinct values (lengths, mostly) do not fill the memory of
+// the process. The values not in the table are parsed every time
+static const size_t MAX_INTERNED_VALUES = 1024;
+
+static std::atomic<unsigned long> totalHits(0);
+static std::atomic<unsigned long> totalMisses(0);
+static std::atomic<size_t> totalSize(0);
+
 SmartPtr<Value>
 AttributeSignature::getDefaultValue() const
 {
-  if (!defaultValue && defaultUnparsedValue)
-    defaultValue = parseValue(defaultUnparsedValue);
+  // signatures are shared by all threads
+  std::call_once(defaultValueParsed, [this] {
+      if (defaultUnparsedValue) defaultValue = parseValue(defaultUnparsedValue);
+    });
 
   return defaultValue;
 }
@@ -39,7 +51,53 @@ SmartPtr<Value>
 AttributeSignature::parseValue(const String& v) const
 {
   assert(parser);
+  {
+    std::lock_guard<std::mutex> lock(valueTable.mutex);
+    AttributeValueTable::Map::const_iterator p = valueTable.values.find(v);
+    if (p != valueTable.values.end())
+      {
+	valueTable.hits++;
+	totalHits++;
+	return p->second;
+      }
+    valueTable.misses++;
+    totalMisses++;
+  }
+
+  // the parser may be slow, it runs outside the lock. If another
+  // thread interns the same string meanwhile its value is kept
   UCS4String s = UCS4StringOfString(v);
   UCS4String::const_iterator next;
-  return parser(s.begin(), s.end(), next);
+  SmartPtr<Value> value = parser(s.begin(), s.end(), next);
+
+  std::lock_guard<std::mutex> lock(valueTable.mutex);
+  if (valueTable.values.size() < MAX_INTERNED_VALUES)
+    {
+      std::pair<AttributeValueTable::Map::iterator, bool> res =
+	valueTable.values.insert(AttributeValueTable::Map::value_type(v, value));
+      if (res.second) totalSize++;
+      return res.first->second;
+    }
+  return value;
+}
+
+AttributeValueTable::Stats
+AttributeSignature::getValueTableStats() const
+{
+  std::lock_guard<std::mutex> lock(valueTable.mutex);
+  AttributeValueTable::Stats stats;
+  stats.hits = valueTable.hits;
+  stats.misses = valueTable.misses;
+  stats.size = valueTable.values.size();
+  return stats;
+}
+
+AttributeValueTable::Stats
+AttributeSignature::getTotalValueTableStats()
+{
+  AttributeValueTable::Stats stats;
+  stats.hits = totalHits;
+  stats.misses = totalMisses;
+  stats.size = totalSize;
+  return stats;
 }
@@ -23,7 +23,11 @@
 #ifndef __AttributeSignature_hh__
 #define __AttributeSignature_hh__
 
+#include <mutex>
+#include <unordered_map>
+
 #include "String.hh"
+#include "StringHash.hh"
 #include "Value.hh"
 #include "SmartPtr.hh"
 
@@ -31,6 +35,28 @@ typedef SmartPtr<Value> (*AttributeParser)(const UCS4String::const_iterator&,
 					   const UCS4String::const_iterator&,
 					   UCS4String::const_iterator&);
 
+// the values parsed for a signature, every distinct unparsed value is
+// parsed once per process and the result is shared by all the
+// attributes with that value. Values are immutable, so the table can
+// be shared by all threads
+struct AttributeValueTable
+{
+  struct Stats
+  {
+    Stats(void) : hits(0), misses(0), size(0) { }
+
+    unsigned long hits;
+    unsigned long misses;
+    size_t size;
+  };
+
+  typedef std::unordered_map<String, SmartPtr<Value>, StringHash, StringEq> Map;
+  std::mutex mutex;
+  Map values;
+  unsigned long hits;
+  unsigned long misses;
+};
+
 struct AttributeSignature
 {
   String name;
@@ -42,9 +68,17 @@ struct AttributeSignature
   bool emptyMeaningful;
   const char* defaultUnparsedValue;
   mutable SmartPtr<Value> defaultValue;
+  mutable std::once_flag defaultValueParsed;
+  mutable AttributeValueTable valueTable;
 
   SmartPtr<Value> getDefaultValue(void) const;
+  // returns the interned value for the string, parsing it the first
+  // time it is seen. A null value means the string is not valid
   SmartPtr<Value> parseValue(const String&) const;
+
+  AttributeValueTable::Stats getValueTableStats(void) const;
+  // the sum of the statistics of all the signatures
+  static AttributeValueTable::Stats getTotalValueTableStats(void);
 };
 
 typedef const AttributeSignature* AttributeId;
@@ -61,6 +95,6 @@ typedef const AttributeSignature* AttributeId;
 #define DECLARE_ATTRIBUTE(ns,el,name) extern const AttributeSignature ATTRIBUTE_SIGNATURE(ns,el,name)
 #define DEFINE_ATTRIBUTE(ns,el,name,fe,fc,de,em,df) \
   const AttributeSignature ATTRIBUTE_SIGNATURE(ns,el,name) = \
-  { #name, ATTRIBUTE_FULL_NAME(ns,el,name), ATTRIBUTE_PARSER(ns,el,name), fe, fc, de, em, df, 0 }
+  { #name, ATTRIBUTE_FULL_NAME(ns,el,name), ATTRIBUTE_PARSER(ns,el,name), fe, fc, de, em, df, 0, {}, {} }
 
 #endif // __AttributeSignature_hh__
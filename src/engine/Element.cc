@@ -31,7 +31,7 @@
 #include "AttributeSet.hh"
 #include "NamespaceContext.hh"
 
-Element::Element(const SmartPtr<NamespaceContext>& c) : context(c)
+Element::Element(const SmartPtr<NamespaceContext>& c, Kind kind) : Node(kind), context(c)
 {
   assert(context);
   setDirtyStructure();
@@ -91,15 +91,33 @@ void
 Element::setAttribute(const SmartPtr<Attribute>& attr)
 {
   assert(attr);
-  if (!attributes) attributes = AttributeSet::create();
+  if (!attributes)
+    attributes = AttributeSet::create();
+  else if (attributes->isShared())
+    {
+      // the set may be referenced by other elements too
+      SmartPtr<Attribute> old = attributes->get(ATTRIBUTE_ID_OF_SIGNATURE(attr->getSignature()));
+      if (old && old->equal(attr)) return;
+      attributes = attributes->clone();
+    }
   if (attributes->set(attr)) setDirtyLayout();
 }
 
 void
 Element::removeAttribute(const AttributeSignature& signature)
 {
-  if (attributes && attributes->remove(ATTRIBUTE_ID_OF_SIGNATURE(signature)))
-    setDirtyLayout();
+  if (!attributes || !attributes->has(ATTRIBUTE_ID_OF_SIGNATURE(signature)))
+    return;
+  if (attributes->isShared())
+    attributes = attributes->clone();
+  attributes->remove(ATTRIBUTE_ID_OF_SIGNATURE(signature));
+  setDirtyLayout();
+}
+
+void
+Element::shareAttributes(AttributeSetPool& pool)
+{
+  if (attributes) attributes = pool.share(attributes);
 }
 
 SmartPtr<Value>
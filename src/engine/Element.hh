@@ -32,10 +32,12 @@
 class Element : public Node
 {
 protected:
-  Element(const SmartPtr<class NamespaceContext>&);
+  Element(const SmartPtr<class NamespaceContext>&, Kind = KElement);
   virtual ~Element();
 
 public:
+  DECLARE_KIND(Element, Node, KFirstElement, KLastElement)
+
   static bool hasParentLink(void) { return true; }
   static void setParent(Element* self, const SmartPtr<Element>& el) { self->setParent(el); }
 
@@ -47,9 +49,11 @@ public:
   template <typename T> SmartPtr<T> getParent(void) const { return smart_cast<T>(getParent()); }
   unsigned getDepth(void) const;
 
-  void setAttribute(const SmartPtr<class Attribute>&);
-  void removeAttribute(const struct AttributeSignature&);
+  virtual void setAttribute(const SmartPtr<class Attribute>&);
+  virtual void removeAttribute(const struct AttributeSignature&);
   SmartPtr<class Attribute> getAttribute(const struct AttributeSignature&) const;
+  // replaces the attribute set with the equal one found in the pool
+  void shareAttributes(class AttributeSetPool&);
   SmartPtr<class Value> getAttributeValue(const struct AttributeSignature&) const;
   SmartPtr<class Value> getAttributeValueNoDefault(const struct AttributeSignature&) const;
 
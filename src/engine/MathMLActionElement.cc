@@ -33,7 +33,7 @@
 #include "ValueConversion.hh"
 
 MathMLActionElement::MathMLActionElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLLinearContainerElement(context)
+  : MathMLLinearContainerElement(context, KMathMLActionElement)
 {
   selection = 0;
 }
@@ -46,24 +46,15 @@ MathMLActionElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
 
-      if (SmartPtr<Value> value = GET_ATTRIBUTE_VALUE(MathML, Action, selection))
-	selection = ToInteger(value) - 1;
-      else
-	selection = 0;
+      selection = getSelectedIndex();
 
       if (SmartPtr<Value> vAction = GET_ATTRIBUTE_VALUE(MathML, Action, actiontype))
 	{
 	  String action = ToString(vAction);
-
-	  if (action == "toggle")
-	    {
-	      // nothing to do, selecting the element is just fine
-	      // but we want to have cycling
-	      selection %= getSize();
-	    }
-	  else
+	  if (action != "toggle")
 	    getLogger()->out(LOG_WARNING, "action `%s' is not supported (ignored)", action.c_str());
 	}
       else
@@ -85,11 +76,30 @@ MathMLActionElement::format(FormattingContext& ctxt)
   return getArea();
 }
 
+unsigned
+MathMLActionElement::getSelectedIndex() const
+{
+  unsigned index = 0;
+  if (SmartPtr<Value> value = GET_ATTRIBUTE_VALUE(MathML, Action, selection))
+    index = ToInteger(value) - 1;
+
+  // selecting the element is just fine for toggle actions, but we want
+  // to have cycling
+  if (SmartPtr<Value> vAction = GET_ATTRIBUTE_VALUE(MathML, Action, actiontype))
+    if (ToString(vAction) == "toggle" && getSize() > 0)
+      index %= getSize();
+
+  return index;
+}
+
 SmartPtr<MathMLOperatorElement>
-MathMLActionElement::getCoreOperator()
+MathMLActionElement::computeCoreOperator()
 {
-  if (selection < getSize())
-    if (SmartPtr<MathMLElement> elem = getChild(selection))
+  // the core operator may be needed before the element is formatted,
+  // so the selection cannot be taken from the last layout
+  const unsigned index = getSelectedIndex();
+  if (index < getSize())
+    if (SmartPtr<MathMLElement> elem = getChild(index))
       return elem->getCoreOperator();
   return nullptr;
 }
@@ -34,15 +34,20 @@ protected:
   virtual ~MathMLActionElement();
 
 public:
+  DECLARE_KIND(MathMLActionElement, Node, KMathMLActionElement, KMathMLActionElement)
+
   static SmartPtr<MathMLActionElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLActionElement(view); }
 
   virtual AreaRef format(class FormattingContext&);
 
-  virtual SmartPtr<MathMLOperatorElement> getCoreOperator(void);
-
 private:
+  unsigned getSelectedIndex(void) const;
+
   unsigned selection;
+
+protected:
+  virtual SmartPtr<MathMLOperatorElement> computeCoreOperator(void);
 };
 
 #endif // __MathMLActionElement_hh__
@@ -30,7 +30,7 @@
 #include "MathMLAlignGroupElement.hh"
 
 MathMLAlignGroupElement::MathMLAlignGroupElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLElement(context)
+  : MathMLElement(context, KMathMLAlignGroupElement)
 { }
 
 MathMLAlignGroupElement::~MathMLAlignGroupElement()
@@ -61,7 +61,7 @@ MathMLAlignGroupElement::SetAlignmentMark(const SmartPtr<class MathMLAlignMarkEl
 }
 
 bool
-MathMLAlignGroupElement::IsSpaceLike() const
+MathMLAlignGroupElement::computeSpaceLike() const
 { return true; }
 
 void
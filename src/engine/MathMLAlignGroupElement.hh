@@ -32,6 +32,8 @@ protected:
   virtual ~MathMLAlignGroupElement();
 
 public:
+  DECLARE_KIND(MathMLAlignGroupElement, Node, KMathMLAlignGroupElement, KMathMLAlignGroupElement)
+
   static SmartPtr<MathMLAlignGroupElement> create(const SmartPtr<class MathMLNamespaceContext>& context)
   { return new MathMLAlignGroupElement(context); }
 
@@ -44,14 +46,15 @@ public:
   const SmartPtr<class MathMLAlignMarkElement>& GetAlignmentMarkElement(void) const { return alignMarkElement; }
   const SmartPtr<class MathMLTokenElement>& GetDecimalPoint(void) const { return decimalPoint; }
 
-  virtual bool IsSpaceLike(void) const;
-
 private:
   scaled width;
 
   SmartPtr<class MathMLMarkNode>         alignMarkNode;
   SmartPtr<class MathMLAlignMarkElement> alignMarkElement;
   SmartPtr<class MathMLTokenElement>     decimalPoint;
+
+protected:
+  virtual bool computeSpaceLike(void) const;
 };
 
 #endif // __MathMLAlignGroupElement_hh__
@@ -29,7 +29,7 @@
 #include "ValueConversion.hh"
 
 MathMLAlignMarkElement::MathMLAlignMarkElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLElement(context)
+  : MathMLElement(context, KMathMLAlignMarkElement)
 {
   edge = T__NOTVALID;
 }
@@ -58,7 +58,7 @@ MathMLAlignMarkElement::DoLayout(const FormattingContext& ctxt)
 #endif
 
 bool
-MathMLAlignMarkElement::IsSpaceLike() const
+MathMLAlignMarkElement::computeSpaceLike() const
 {
   return true;
 }
@@ -33,14 +33,16 @@ protected:
   virtual ~MathMLAlignMarkElement();
 
 public:
+  DECLARE_KIND(MathMLAlignMarkElement, Node, KMathMLAlignMarkElement, KMathMLAlignMarkElement)
+
   static SmartPtr<MathMLAlignMarkElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLAlignMarkElement(view); }
 
-  virtual bool IsSpaceLike(void) const;
-
   TokenId GetAlignmentEdge(void) const { return edge; }
 
 protected:
+  virtual bool computeSpaceLike(void) const;
+
   TokenId edge;
 };
 
@@ -28,8 +28,8 @@
 #include "FormattingContext.hh"
 #include "MathGraphicDevice.hh"
 
-MathMLBinContainerElement::MathMLBinContainerElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLContainerElement(context)
+MathMLBinContainerElement::MathMLBinContainerElement(const SmartPtr<class MathMLNamespaceContext>& context, Kind kind)
+  : MathMLContainerElement(context, kind)
 { }
 
 MathMLBinContainerElement::~MathMLBinContainerElement()
@@ -40,6 +40,7 @@ MathMLBinContainerElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
       AreaRef res = getChild() ? getChild()->format(ctxt) : nullptr;
       setArea(res ? ctxt.MGD()->wrapper(ctxt, res) : nullptr);
@@ -30,10 +30,12 @@
 class MathMLBinContainerElement : public MathMLContainerElement
 {
 protected:
-  MathMLBinContainerElement(const SmartPtr<class MathMLNamespaceContext>& view);
+  MathMLBinContainerElement(const SmartPtr<class MathMLNamespaceContext>& view, Kind);
   virtual ~MathMLBinContainerElement();
 
 public:
+  DECLARE_KIND(MathMLBinContainerElement, Node, KFirstMathMLBinContainerElement, KLastMathMLBinContainerElement)
+
   virtual AreaRef format(class FormattingContext&);
 
   SmartPtr<MathMLElement> getChild(void) const { return content.getChild(); }
@@ -26,7 +26,7 @@
 
 #include "MathMLContainerElement.hh"
 
-MathMLContainerElement::MathMLContainerElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLElement(context)
+MathMLContainerElement::MathMLContainerElement(const SmartPtr<class MathMLNamespaceContext>& context, Kind kind)
+  : MathMLElement(context, kind)
 { }
 
@@ -29,7 +29,10 @@
 class MathMLContainerElement : public MathMLElement
 {
 protected:
-  MathMLContainerElement(const SmartPtr<class MathMLNamespaceContext>&);
+  MathMLContainerElement(const SmartPtr<class MathMLNamespaceContext>&, Kind);
+
+public:
+  DECLARE_KIND(MathMLContainerElement, Node, KFirstMathMLContainerElement, KLastMathMLContainerElement)
 };
 
 #endif // __MathMLContainerElement_hh__
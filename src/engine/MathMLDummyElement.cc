@@ -29,7 +29,7 @@
 #include "MathGraphicDevice.hh"
 
 MathMLDummyElement::MathMLDummyElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLElement(context)
+  : MathMLElement(context, KMathMLDummyElement)
 { }
 
 MathMLDummyElement::~MathMLDummyElement()
@@ -40,6 +40,7 @@ MathMLDummyElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
       setArea(ctxt.MGD()->dummy(ctxt));
       ctxt.pop();
@@ -32,6 +32,8 @@ protected:
   virtual ~MathMLDummyElement();
 
 public:
+  DECLARE_KIND(MathMLDummyElement, Node, KMathMLDummyElement, KMathMLDummyElement)
+
   static SmartPtr<MathMLDummyElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLDummyElement(view); }
 
@@ -31,24 +31,36 @@
 #include "ValueConversion.hh"
 #include "Variant.hh"
 
-MathMLElement::MathMLElement(const SmartPtr<MathMLNamespaceContext>& context) : Element(context)
+MathMLElement::MathMLElement(const SmartPtr<MathMLNamespaceContext>& context, Kind kind)
+  : Element(context, kind), spaceLikeValid(false), spaceLike(false), coreOperatorValid(false), coreOperator(0)
 { }
 
 MathMLElement::~MathMLElement()
 { }
 
 bool
-MathMLElement::IsSpaceLike() const
+MathMLElement::computeSpaceLike() const
 {
   return false;
 }
 
 SmartPtr<MathMLOperatorElement>
-MathMLElement::getCoreOperator()
+MathMLElement::computeCoreOperator()
 {
   return nullptr;
 }
 
+SmartPtr<MathMLOperatorElement>
+MathMLElement::getCoreOperator()
+{
+  if (!coreOperatorValid)
+    {
+      coreOperator = computeCoreOperator();
+      coreOperatorValid = true;
+    }
+  return coreOperator;
+}
+
 SmartPtr<MathMLOperatorElement>
 MathMLElement::getCoreOperatorTop()
 {
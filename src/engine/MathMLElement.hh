@@ -30,16 +30,38 @@
 class MathMLElement : public Element
 {
 protected:
-  MathMLElement(const SmartPtr<class MathMLNamespaceContext>&);
+  MathMLElement(const SmartPtr<class MathMLNamespaceContext>&, Kind);
   virtual ~MathMLElement();
 
 public:
-  virtual bool IsSpaceLike(void) const;
+  DECLARE_KIND(MathMLElement, Node, KFirstMathMLElement, KLastMathMLElement)
 
-  virtual SmartPtr<class MathMLOperatorElement> getCoreOperator(void);
+  // whether the element is space-like and which operator is its core
+  // only depend on the structure and the attributes of the element and
+  // of its descendants. They are computed when first needed and kept
+  // until the builder updates the element again
+  bool IsSpaceLike(void) const
+  {
+    if (!spaceLikeValid) { spaceLike = computeSpaceLike(); spaceLikeValid = true; }
+    return spaceLike;
+  }
+  SmartPtr<class MathMLOperatorElement> getCoreOperator(void);
   SmartPtr<class MathMLOperatorElement> getCoreOperatorTop(void);
+  void resetStructuralProperties(void) { spaceLikeValid = coreOperatorValid = false; }
 
   SmartPtr<class MathMLNamespaceContext> getMathMLNamespaceContext(void) const;
+
+protected:
+  virtual bool computeSpaceLike(void) const;
+  virtual SmartPtr<class MathMLOperatorElement> computeCoreOperator(void);
+
+private:
+  mutable bool spaceLikeValid : 1;
+  mutable bool spaceLike : 1;
+  bool coreOperatorValid : 1;
+  // the core operator is a descendant of the element (or the element
+  // itself) and it is kept alive by the tree
+  class MathMLOperatorElement* coreOperator;
 };
 
 #endif // __MathMLElement_hh__
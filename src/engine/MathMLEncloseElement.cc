@@ -32,7 +32,7 @@
 #include "MathMLAttributeSignatures.hh"
 
 MathMLEncloseElement::MathMLEncloseElement(const SmartPtr<MathMLNamespaceContext>& context)
-  : MathMLNormalizingContainerElement(context)
+  : MathMLNormalizingContainerElement(context, KMathMLEncloseElement)
 { }
 
 MathMLEncloseElement::~MathMLEncloseElement()
@@ -43,6 +43,7 @@ MathMLEncloseElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
 
       AreaRef res;
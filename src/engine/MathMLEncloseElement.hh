@@ -33,6 +33,8 @@ protected:
   virtual ~MathMLEncloseElement();
 
 public:
+  DECLARE_KIND(MathMLEncloseElement, Node, KMathMLEncloseElement, KMathMLEncloseElement)
+
   static SmartPtr<MathMLEncloseElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLEncloseElement(view); }
 
@@ -29,7 +29,7 @@
 #include "MathGraphicDevice.hh"
 
 MathMLErrorElement::MathMLErrorElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLNormalizingContainerElement(context)
+  : MathMLNormalizingContainerElement(context, KMathMLErrorElement)
 { }
 
 MathMLErrorElement::~MathMLErrorElement()
@@ -40,6 +40,7 @@ MathMLErrorElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
       if (ctxt.getColor() == RGBColor::RED()) ctxt.setColor(RGBColor::BLUE());
       else ctxt.setColor(RGBColor::RED());
@@ -32,6 +32,8 @@ protected:
   virtual ~MathMLErrorElement();
 
 public:
+  DECLARE_KIND(MathMLErrorElement, Node, KMathMLErrorElement, KMathMLErrorElement)
+
   static SmartPtr<MathMLErrorElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLErrorElement(view); }
 
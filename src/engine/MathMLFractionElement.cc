@@ -34,7 +34,7 @@
 #include "MathMLAttributeSignatures.hh"
 
 MathMLFractionElement::MathMLFractionElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLContainerElement(context)
+  : MathMLContainerElement(context, KMathMLFractionElement)
 { }
 
 MathMLFractionElement::~MathMLFractionElement()
@@ -45,6 +45,7 @@ MathMLFractionElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       Length thickness;
       if (SmartPtr<Value> value = GET_ATTRIBUTE_VALUE(MathML, Fraction, linethickness))
 	{
@@ -139,7 +140,7 @@ MathMLFractionElement::resetFlagDown(Flags f)
 }
 
 SmartPtr<MathMLOperatorElement>
-MathMLFractionElement::getCoreOperator()
+MathMLFractionElement::computeCoreOperator()
 {
   return getNumerator() ? getNumerator()->getCoreOperator() : nullptr;
 }
@@ -35,6 +35,8 @@ protected:
   virtual ~MathMLFractionElement();
 
 public:
+  DECLARE_KIND(MathMLFractionElement, Node, KMathMLFractionElement, KMathMLFractionElement)
+
   static SmartPtr<MathMLFractionElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLFractionElement(view); }
 
@@ -43,8 +45,6 @@ public:
   virtual void   setFlagDown(Flags);
   virtual void   resetFlagDown(Flags);
 
-  virtual SmartPtr<class MathMLOperatorElement> getCoreOperator(void);
-
   SmartPtr<MathMLElement> getNumerator(void) const { return numerator.getChild(); }
   SmartPtr<MathMLElement> getDenominator(void) const { return denominator.getChild(); }
   void setNumerator(const SmartPtr<MathMLElement>& child) { numerator.setChild(this, child); }
@@ -53,6 +53,9 @@ public:
 private:
   BinContainerTemplate<MathMLFractionElement,MathMLElement> numerator;
   BinContainerTemplate<MathMLFractionElement,MathMLElement> denominator;
+
+protected:
+  virtual SmartPtr<class MathMLOperatorElement> computeCoreOperator(void);
 };
 
 #endif // __MathMLFractionElement_hh__
@@ -28,10 +28,12 @@
 class MathMLFunctionApplicationNode : public MathMLTextNode
 {
 protected:
-  MathMLFunctionApplicationNode(void) { }
+  MathMLFunctionApplicationNode(void) : MathMLTextNode(KMathMLFunctionApplicationNode) { }
   virtual ~MathMLFunctionApplicationNode() { }
 
 public:
+  DECLARE_KIND(MathMLFunctionApplicationNode, Node, KMathMLFunctionApplicationNode, KMathMLFunctionApplicationNode)
+
   static SmartPtr<MathMLFunctionApplicationNode> create(void)
   { return SmartPtr<MathMLFunctionApplicationNode>(new MathMLFunctionApplicationNode()); }
 
@@ -29,7 +29,7 @@
 #include "MathGraphicDevice.hh"
 
 MathMLGlyphNode::MathMLGlyphNode(const String& f, const String& i, const String& a)
-  : family(f), index(i), alt(a)
+  : MathMLTextNode(KMathMLGlyphNode), family(f), index(i), alt(a)
 { }
 
 MathMLGlyphNode::~MathMLGlyphNode()
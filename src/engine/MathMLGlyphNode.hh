@@ -32,6 +32,8 @@ protected:
   virtual ~MathMLGlyphNode();
 
 public:
+  DECLARE_KIND(MathMLGlyphNode, Node, KMathMLGlyphNode, KMathMLGlyphNode)
+
   static SmartPtr<MathMLGlyphNode> create(const String& family, const String& index, const String& alt)
   { return new MathMLGlyphNode(family, index, alt); }
 
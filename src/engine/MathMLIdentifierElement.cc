@@ -25,7 +25,7 @@
 #include "MathMLIdentifierElement.hh"
 
 MathMLIdentifierElement::MathMLIdentifierElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLTokenElement(context)
+  : MathMLTokenElement(context, KMathMLIdentifierElement)
 { }
 
 MathMLIdentifierElement::~MathMLIdentifierElement()
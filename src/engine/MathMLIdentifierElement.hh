@@ -32,6 +32,8 @@ protected:
   virtual ~MathMLIdentifierElement();
 
 public:
+  DECLARE_KIND(MathMLIdentifierElement, Node, KMathMLIdentifierElement, KMathMLIdentifierElement)
+
   static SmartPtr<MathMLIdentifierElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLIdentifierElement(view); }
 };
@@ -25,7 +25,7 @@
 #include "MathMLInferredRowElement.hh"
 
 MathMLInferredRowElement::MathMLInferredRowElement(const SmartPtr<MathMLNamespaceContext>& ctxt)
-  : MathMLRowElement(ctxt)
+  : MathMLRowElement(ctxt, KMathMLInferredRowElement)
 { }
 
 MathMLInferredRowElement::~MathMLInferredRowElement()
@@ -32,6 +32,8 @@ protected:
   virtual ~MathMLInferredRowElement();
 
 public:
+  DECLARE_KIND(MathMLInferredRowElement, Node, KMathMLInferredRowElement, KMathMLInferredRowElement)
+
   static SmartPtr<MathMLInferredRowElement> create(const SmartPtr<class MathMLNamespaceContext>& view);
 };
 
@@ -28,10 +28,12 @@
 class MathMLInvisibleTimesNode : public MathMLTextNode
 {
 protected:
-  MathMLInvisibleTimesNode(void) { }
+  MathMLInvisibleTimesNode(void) : MathMLTextNode(KMathMLInvisibleTimesNode) { }
   virtual ~MathMLInvisibleTimesNode() { }
 
 public:
+  DECLARE_KIND(MathMLInvisibleTimesNode, Node, KMathMLInvisibleTimesNode, KMathMLInvisibleTimesNode)
+
   static SmartPtr<MathMLInvisibleTimesNode> create(void)
   { return SmartPtr<MathMLInvisibleTimesNode>(new MathMLInvisibleTimesNode()); }
 
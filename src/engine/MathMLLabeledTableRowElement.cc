@@ -33,7 +33,7 @@
 #include "ValueConversion.hh"
 
 MathMLLabeledTableRowElement::MathMLLabeledTableRowElement(const SmartPtr<MathMLNamespaceContext>& context)
-  : MathMLTableRowElement(context)
+  : MathMLTableRowElement(context, KMathMLLabeledTableRowElement)
 { }
 
 MathMLLabeledTableRowElement::~MathMLLabeledTableRowElement()
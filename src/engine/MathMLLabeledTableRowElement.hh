@@ -33,6 +33,8 @@ protected:
   virtual ~MathMLLabeledTableRowElement();
 
 public:
+  DECLARE_KIND(MathMLLabeledTableRowElement, Node, KMathMLLabeledTableRowElement, KMathMLLabeledTableRowElement)
+
   static SmartPtr<MathMLLabeledTableRowElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLLabeledTableRowElement(view); }
 
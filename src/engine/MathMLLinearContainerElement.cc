@@ -24,8 +24,8 @@
 
 #include "MathMLLinearContainerElement.hh"
 
-MathMLLinearContainerElement::MathMLLinearContainerElement(const SmartPtr<MathMLNamespaceContext>& context)
-  : MathMLContainerElement(context)
+MathMLLinearContainerElement::MathMLLinearContainerElement(const SmartPtr<MathMLNamespaceContext>& context, Kind kind)
+  : MathMLContainerElement(context, kind)
 { }
 
 MathMLLinearContainerElement::~MathMLLinearContainerElement()
@@ -31,10 +31,12 @@
 class MathMLLinearContainerElement : public MathMLContainerElement
 {
 protected:
-  MathMLLinearContainerElement(const SmartPtr<class MathMLNamespaceContext>&);
+  MathMLLinearContainerElement(const SmartPtr<class MathMLNamespaceContext>&, Kind);
   virtual ~MathMLLinearContainerElement();
 
 public:
+  DECLARE_KIND(MathMLLinearContainerElement, Node, KFirstMathMLLinearContainerElement, KLastMathMLLinearContainerElement)
+
   unsigned getSize(void) const { return content.getSize(); }
   void setSize(unsigned size) { content.setSize(this, size); }
 
@@ -27,6 +27,7 @@
 #include "MathMLMarkNode.hh"
 
 MathMLMarkNode::MathMLMarkNode(TokenId e)
+  : MathMLTextNode(KMathMLMarkNode)
 { edge = e; }
 
 MathMLMarkNode::~MathMLMarkNode()
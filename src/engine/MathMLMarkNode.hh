@@ -33,6 +33,8 @@ protected:
   virtual ~MathMLMarkNode();
 
 public:
+  DECLARE_KIND(MathMLMarkNode, Node, KMathMLMarkNode, KMathMLMarkNode)
+
   static SmartPtr<MathMLMarkNode> create(TokenId t)
   { return new MathMLMarkNode(t); }
   
@@ -33,7 +33,7 @@
 #include "ValueConversion.hh"
 
 MathMLMultiScriptsElement::MathMLMultiScriptsElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLContainerElement(context)
+  : MathMLContainerElement(context, KMathMLMultiScriptsElement)
 { }
 
 MathMLMultiScriptsElement::~MathMLMultiScriptsElement()
@@ -67,6 +67,7 @@ MathMLMultiScriptsElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
 
       assert(getBase());
@@ -203,7 +204,7 @@ MathMLMultiScriptsElement::DoLayout(const class FormattingContext& ctxt)
 #endif
 
 SmartPtr<MathMLOperatorElement>
-MathMLMultiScriptsElement::getCoreOperator()
+MathMLMultiScriptsElement::computeCoreOperator()
 {
   return getBase() ? getBase()->getCoreOperator() : nullptr;
 }
@@ -36,6 +36,8 @@ protected:
   virtual ~MathMLMultiScriptsElement();
 
 public:
+  DECLARE_KIND(MathMLMultiScriptsElement, Node, KMathMLMultiScriptsElement, KMathMLMultiScriptsElement)
+
   static SmartPtr<MathMLMultiScriptsElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLMultiScriptsElement(view); }
 
@@ -58,7 +60,6 @@ public:
 
   virtual void setFlagDown(Flags);
   virtual void resetFlagDown(Flags);
-  virtual SmartPtr<class MathMLOperatorElement> getCoreOperator(void);
 
 private:
   static void formatScripts(class FormattingContext&,
@@ -77,6 +78,9 @@ private:
 
   scaled superShiftX;
   scaled superShiftY;
+
+protected:
+  virtual SmartPtr<class MathMLOperatorElement> computeCoreOperator(void);
 };
 
 #endif // __MathMLMultiScriptsElement_hh__
@@ -27,7 +27,7 @@
 #include "MathMLNode.hh"
 #include "MathMLElement.hh"
 
-MathMLNode::MathMLNode()
+MathMLNode::MathMLNode(Kind kind) : Node(kind)
 { }
 
 MathMLNode::~MathMLNode()
@@ -30,8 +30,11 @@
 class MathMLNode : public Node
 {
 protected:
-  MathMLNode(void);
+  MathMLNode(Kind);
   virtual ~MathMLNode();
+
+public:
+  DECLARE_KIND(MathMLNode, Node, KFirstMathMLNode, KLastMathMLNode)
 };
 
 #endif // __MathMLNode_hh__
@@ -29,8 +29,8 @@
 #include "MathMLNormalizingContainerElement.hh"
 #include "MathMLInferredRowElement.hh"
 
-MathMLNormalizingContainerElement::MathMLNormalizingContainerElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLBinContainerElement(context)
+MathMLNormalizingContainerElement::MathMLNormalizingContainerElement(const SmartPtr<class MathMLNamespaceContext>& context, Kind kind)
+  : MathMLBinContainerElement(context, kind)
 { }
 
 MathMLNormalizingContainerElement::~MathMLNormalizingContainerElement()
@@ -41,6 +41,7 @@ MathMLNormalizingContainerElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
       AreaRef res = getChild() ? getChild()->format(ctxt) : nullptr;
       if (res) res = ctxt.MGD()->wrapper(ctxt, res);
@@ -30,10 +30,12 @@
 class MathMLNormalizingContainerElement : public MathMLBinContainerElement
 {
 protected:
-  MathMLNormalizingContainerElement(const SmartPtr<class MathMLNamespaceContext>&);
+  MathMLNormalizingContainerElement(const SmartPtr<class MathMLNamespaceContext>&, Kind);
   virtual ~MathMLNormalizingContainerElement();
 
 public:
+  DECLARE_KIND(MathMLNormalizingContainerElement, Node, KFirstMathMLBinContainerElement, KLastMathMLBinContainerElement)
+
   virtual AreaRef format(class FormattingContext&);
 
   virtual void setDirtyStructure(void);
@@ -25,7 +25,7 @@
 #include "MathMLNumberElement.hh"
 
 MathMLNumberElement::MathMLNumberElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLTokenElement(context)
+  : MathMLTokenElement(context, KMathMLNumberElement)
 { }
 
 MathMLNumberElement::~MathMLNumberElement()
@@ -32,6 +32,8 @@ protected:
   virtual ~MathMLNumberElement();
 
 public:
+  DECLARE_KIND(MathMLNumberElement, Node, KMathMLNumberElement, KMathMLNumberElement)
+
   static SmartPtr<MathMLNumberElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLNumberElement(view); }
 };
@@ -22,10 +22,11 @@
 
 #include <config.h>
 #include <cassert>
+#include <cstring>
+
+#include <algorithm>
 
-#include "StringAux.hh"
 #include "Attribute.hh"
-#include "AbstractLogger.hh"
 #include "MathMLAttributeSignatures.hh"
 #include "MathMLOperatorDictionary.hh"
 #include "AttributeSet.hh"
@@ -44,48 +45,38 @@ struct OperatorDictionaryEntry {
   const char* separator;
   const char* stretchy;
   const char* symmetric;
-} dictionary[] = {
+};
+
+// dumpOperatorDictionary emits the entries sorted by name, the entries
+// for the different forms of an operator are adjacent
+static const OperatorDictionaryEntry dictionary[] = {
 #include "operatorDictionary.cc"
 };
 
-MathMLOperatorDictionary::MathMLOperatorDictionary()
+static const size_t dictionarySize = sizeof(dictionary) / sizeof(dictionary[0]);
+
+static bool
+entryNameLess(const OperatorDictionaryEntry& entry, const char* name)
 {
-  for (auto & entry : dictionary)
-    {
-      String form(entry.form);
-      String opName(entry.name);
-      FormDefaults& formDefaults = items[opName];
-      SmartPtr<AttributeSet> defaults = AttributeSet::create();
-
-      getAttribute(entry.accent, ATTRIBUTE_SIGNATURE(MathML, Operator, accent), defaults);
-      getAttribute(entry.fence, ATTRIBUTE_SIGNATURE(MathML, Operator, fence), defaults);
-      getAttribute(entry.form, ATTRIBUTE_SIGNATURE(MathML, Operator, form), defaults);
-      getAttribute(entry.largeop, ATTRIBUTE_SIGNATURE(MathML, Operator, largeop), defaults);
-      getAttribute(entry.lspace, ATTRIBUTE_SIGNATURE(MathML, Operator, lspace), defaults);
-    //getAttribute(entry.maxsize, ATTRIBUTE_SIGNATURE(MathML, Operator, maxsize), defaults);
-    //getAttribute(entry.minsize, ATTRIBUTE_SIGNATURE(MathML, Operator, minsize), defaults);
-      getAttribute(entry.movablelimits, ATTRIBUTE_SIGNATURE(MathML, Operator, movablelimits), defaults);
-      getAttribute(entry.rspace, ATTRIBUTE_SIGNATURE(MathML, Operator, rspace), defaults);
-      getAttribute(entry.separator, ATTRIBUTE_SIGNATURE(MathML, Operator, separator), defaults);
-      getAttribute(entry.stretchy, ATTRIBUTE_SIGNATURE(MathML, Operator, stretchy), defaults);
-      getAttribute(entry.symmetric, ATTRIBUTE_SIGNATURE(MathML, Operator, symmetric), defaults);
-
-      if (form == "prefix")
-        formDefaults.prefix = defaults;
-      else if (form == "infix")
-        formDefaults.infix = defaults;
-      else if (form == "postfix")
-        formDefaults.postfix = defaults;
-      //else
-      //  logger.out(LOG_WARNING,
-      //           "invalid `form' attribute for entry `%s' in operator dictionary (ignored)",
-      //           escape(UCS4StringOfString(opName)).c_str());
-    }
+  return strcmp(entry.name, name) < 0;
 }
 
+MathMLOperatorDictionary::MathMLOperatorDictionary()
+  : defaults(new SmartPtr<AttributeSet>[dictionarySize]),
+    defaultsBuilt(new std::once_flag[dictionarySize]),
+    defaultsPool(new AttributeSetPool)
+{ }
+
 MathMLOperatorDictionary::~MathMLOperatorDictionary()
 { }
 
+SmartPtr<MathMLOperatorDictionary>
+MathMLOperatorDictionary::getDefault()
+{
+  static const SmartPtr<MathMLOperatorDictionary> dictionary = create();
+  return dictionary;
+}
+
 void
 MathMLOperatorDictionary::getAttribute(const char* value,
                                        const AttributeSignature& signature,
@@ -94,10 +85,42 @@ MathMLOperatorDictionary::getAttribute(const char* value,
   if (value)
     {
       SmartPtr<Attribute> attribute = Attribute::create(signature, value);
+      // values are parsed lazily, parse them now so that the attribute
+      // set is never modified once it is published
+      attribute->getValue();
       aList->set(attribute);
     }
 }
 
+SmartPtr<AttributeSet>
+MathMLOperatorDictionary::getDefaults(size_t i) const
+{
+  assert(i < dictionarySize);
+  std::call_once(defaultsBuilt[i], [this, i] {
+      const OperatorDictionaryEntry& entry = dictionary[i];
+      SmartPtr<AttributeSet> aList = AttributeSet::create();
+
+      getAttribute(entry.accent, ATTRIBUTE_SIGNATURE(MathML, Operator, accent), aList);
+      getAttribute(entry.fence, ATTRIBUTE_SIGNATURE(MathML, Operator, fence), aList);
+      getAttribute(entry.form, ATTRIBUTE_SIGNATURE(MathML, Operator, form), aList);
+      getAttribute(entry.largeop, ATTRIBUTE_SIGNATURE(MathML, Operator, largeop), aList);
+      getAttribute(entry.lspace, ATTRIBUTE_SIGNATURE(MathML, Operator, lspace), aList);
+    //getAttribute(entry.maxsize, ATTRIBUTE_SIGNATURE(MathML, Operator, maxsize), aList);
+    //getAttribute(entry.minsize, ATTRIBUTE_SIGNATURE(MathML, Operator, minsize), aList);
+      getAttribute(entry.movablelimits, ATTRIBUTE_SIGNATURE(MathML, Operator, movablelimits), aList);
+      getAttribute(entry.rspace, ATTRIBUTE_SIGNATURE(MathML, Operator, rspace), aList);
+      getAttribute(entry.separator, ATTRIBUTE_SIGNATURE(MathML, Operator, separator), aList);
+      getAttribute(entry.stretchy, ATTRIBUTE_SIGNATURE(MathML, Operator, stretchy), aList);
+      getAttribute(entry.symmetric, ATTRIBUTE_SIGNATURE(MathML, Operator, symmetric), aList);
+
+      // many entries have the same attributes, they share one set
+      std::lock_guard<std::mutex> lock(defaultsMutex);
+      defaults[i] = defaultsPool->share(aList);
+    });
+
+  return defaults[i];
+}
+
 void
 MathMLOperatorDictionary::search(const String& opName,
 				 SmartPtr<AttributeSet>& prefix,
@@ -106,12 +129,20 @@ MathMLOperatorDictionary::search(const String& opName,
 {
   prefix = infix = postfix = nullptr;
 
-  auto p = items.find(opName);
-  if (p != items.end())
+  const OperatorDictionaryEntry* begin = dictionary;
+  const OperatorDictionaryEntry* end = dictionary + dictionarySize;
+  for (const OperatorDictionaryEntry* entry = std::lower_bound(begin, end, opName.c_str(), entryNameLess);
+       entry != end && opName == entry->name;
+       entry++)
     {
-      prefix = (*p).second.prefix;
-      infix = (*p).second.infix;
-      postfix = (*p).second.postfix;
+      const char* form = entry->form;
+      if (!form) continue;
+
+      if (strcmp(form, "prefix") == 0)
+	prefix = getDefaults(entry - begin);
+      else if (strcmp(form, "infix") == 0)
+	infix = getDefaults(entry - begin);
+      else if (strcmp(form, "postfix") == 0)
+	postfix = getDefaults(entry - begin);
     }
 }
-
@@ -23,11 +23,12 @@
 #ifndef __MathMLOperatorDictionary_hh__
 #define __MathMLOperatorDictionary_hh__
 
+#include <memory>
+#include <mutex>
+
 #include "AttributeSignature.hh"
 #include "SmartPtr.hh"
 #include "String.hh"
-#include "StringHash.hh"
-#include <unordered_map>
 #include "Object.hh"
 
 class MathMLOperatorDictionary : public Object
@@ -38,6 +39,8 @@ protected:
 
 public:
   static SmartPtr<MathMLOperatorDictionary> create(void) { return new MathMLOperatorDictionary; }
+  // the dictionary shared by all the views of the process
+  static SmartPtr<MathMLOperatorDictionary> getDefault(void);
 
   void search(const String&,
 	      SmartPtr<class AttributeSet>&,
@@ -45,19 +48,20 @@ public:
 	      SmartPtr<class AttributeSet>&) const;
 
 private:
-  void getAttribute(const char*,
-                    const AttributeSignature&,
-                    const SmartPtr<AttributeSet>&);
-
-  struct FormDefaults
-  {
-    SmartPtr<class AttributeSet> prefix;
-    SmartPtr<class AttributeSet> infix;
-    SmartPtr<class AttributeSet> postfix;
-  };
+  static void getAttribute(const char*,
+			   const AttributeSignature&,
+			   const SmartPtr<AttributeSet>&);
+  SmartPtr<class AttributeSet> getDefaults(size_t) const;
 
-  typedef std::unordered_map<String,FormDefaults,StringHash,StringEq> Dictionary;
-  Dictionary items;
+  // the entries of the compiled table are turned into attribute sets
+  // the first time they are searched for. Each one is built under its
+  // own once_flag so that the dictionary can be shared by threads
+  std::unique_ptr<SmartPtr<class AttributeSet>[]> defaults;
+  std::unique_ptr<std::once_flag[]> defaultsBuilt;
+  // guards defaultsPool, which is shared by the entries built by
+  // different threads
+  mutable std::mutex defaultsMutex;
+  std::unique_ptr<class AttributeSetPool> defaultsPool;
 };
 
 #endif // __MathMLOperatorDictionary_hh__
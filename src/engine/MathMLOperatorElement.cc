@@ -25,6 +25,7 @@
 #include <cassert>
 
 #include "defs.h" // for EPSILON
+#include "AreaArena.hh"
 #include "AreaFactory.hh"
 #include "AbstractLogger.hh"
 #include "NamespaceContext.hh"
@@ -42,7 +43,7 @@
 #define GET_OPERATOR_ATTRIBUTE_VALUE(ns,el,name,def) getOperatorAttributeValue(ATTRIBUTE_SIGNATURE(ns,el,name),def)
 
 MathMLOperatorElement::MathMLOperatorElement(const SmartPtr<MathMLNamespaceContext>& context)
-  : MathMLTokenElement(context)
+  : MathMLTokenElement(context, KMathMLOperatorElement)
 {
   fence = separator = stretchy = symmetric = accent = movableLimits = largeOp = false;
   forcedFence = forcedSeparator = forcedSymmetric = false;
@@ -56,6 +57,11 @@ MathMLOperatorElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
+      // the unstretched and stretched areas are reused by the rows
+      // across passes, so they must not pin the arena of this one
+      AreaArena::Scope heap(nullptr);
+
       ctxt.push(this);
       
       TokenId form = T__NOTVALID;
@@ -64,84 +70,36 @@ MathMLOperatorElement::format(FormattingContext& ctxt)
       else
 	form = inferOperatorForm();
 
-      SmartPtr<AttributeSet> prefix;
-      SmartPtr<AttributeSet> infix;
-      SmartPtr<AttributeSet> postfix;
-
-      String operatorName = GetRawContent();
-      if (SmartPtr<MathMLOperatorDictionary> dictionary = getNamespaceContext()->getView()->getOperatorDictionary())
-	dictionary->search(operatorName, prefix, infix, postfix);
-
-      SmartPtr<AttributeSet> defaults;
-      if      (form == T_PREFIX && prefix) defaults = prefix;
-      else if (form == T_INFIX && infix) defaults = infix;
-      else if (form == T_POSTFIX && postfix) defaults = postfix;
-      else if (infix) defaults = infix;
-      else if (postfix) defaults = postfix;
-      else if (prefix) defaults = prefix;
-      else defaults = nullptr;
-
-      if (SmartPtr<Value> value = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, fence, defaults))
-	fence = ToBoolean(value);
+      const SmartPtr<MathMLOperatorDictionary> dictionary = getNamespaceContext()->getView()->getOperatorDictionary();
+      if (!resolved.valid || resolved.form != form || resolved.dictionary != dictionary)
+	resolveProperties(form, dictionary);
 
-      if (SmartPtr<Value> value = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, separator, defaults))
-	separator = ToBoolean(value);
-
-      if (SmartPtr<Value> value = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, lspace, defaults))
-	{
-	  if (ctxt.getScriptLevel() <= 0)
-	    lSpace = ctxt.MGD()->evaluate(ctxt, resolveLength(ctxt, value), scaled::zero());
-	  else
-	    lSpace = scaled::zero();
-	}
-      else
-	assert(false);
+      fence = resolved.fence;
+      separator = resolved.separator;
+      stretchy = resolved.stretchy;
+      symmetric = resolved.symmetric;
+      movableLimits = resolved.movableLimits;
+      accent = resolved.accent;
+      largeOp = resolved.largeOp;
 
-      if (SmartPtr<Value> value = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, rspace, defaults))
+      if (ctxt.getScriptLevel() <= 0)
 	{
-	  if (ctxt.getScriptLevel() <= 0)
-	    rSpace = ctxt.MGD()->evaluate(ctxt, resolveLength(ctxt, value), scaled::zero());
-	  else
-	    rSpace = scaled::zero();
+	  lSpace = ctxt.MGD()->evaluate(ctxt, resolveLength(ctxt, resolved.lSpace), scaled::zero());
+	  rSpace = ctxt.MGD()->evaluate(ctxt, resolveLength(ctxt, resolved.rSpace), scaled::zero());
 	}
       else
-	assert(false);
-
-      if (SmartPtr<Value> value = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, stretchy, defaults))
-	stretchy = ToBoolean(value);
-
-      if (SmartPtr<Value> value = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, symmetric, defaults))
-	symmetric = ToBoolean(value);
+	lSpace = rSpace = scaled::zero();
 
       float maxMultiplier = 0.0f;
       scaled maxSize;
-      if (SmartPtr<Value> value = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, maxsize, defaults))
-        {
-	if (ToTokenId(value) == T_INFINITY)
-	  maxSize = scaled::max();
-	else
-	  parseLimitValue(value, ctxt, maxMultiplier, maxSize);
-        }
+      if (ToTokenId(resolved.maxSize) == T_INFINITY)
+	maxSize = scaled::max();
+      else
+	parseLimitValue(resolved.maxSize, ctxt, maxMultiplier, maxSize);
 
       float minMultiplier = 0.0f;
       scaled minSize;
-      if (SmartPtr<Value> value = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, minsize, defaults))
-	parseLimitValue(value, ctxt, minMultiplier, minSize);
-      else
-	assert(false);
-
-      if (SmartPtr<Value> value = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, movablelimits, defaults))
-	movableLimits = ToBoolean(value);
-      else
-	assert(false);
-
-      if (SmartPtr<Value> value = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, accent, defaults))
-	accent = ToBoolean(value);
-      else
-	assert(false);
-
-      if (SmartPtr<Value> value = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, largeop, defaults))
-	largeOp = ToBoolean(value);
+      parseLimitValue(resolved.minSize, ctxt, minMultiplier, minSize);
 
       // Just make large operators stretchy for now. We might want to handle them a bit differently (like TeX) later, though.
       if (largeOp)
@@ -152,7 +110,7 @@ MathMLOperatorElement::format(FormattingContext& ctxt)
 	{
 	  // before stretchying the operator need to be formatted at
 	  // least once
-	  AreaRef minArea = getArea();
+	  AreaRef minArea = unstretchedArea ? unstretchedArea : getArea();
 	  assert(minArea);
 
 	  const BoundingBox minBox = minArea->box();
@@ -222,6 +180,19 @@ MathMLOperatorElement::format(FormattingContext& ctxt)
       res = formatEmbellishment(this, ctxt, res);
       setArea(ctxt.MGD()->wrapper(ctxt, res));
 
+      if (stretchy && this == ctxt.getStretchOperator())
+	{
+	  stretchedArea = getArea();
+	  stretchedToWidth = ctxt.getStretchToWidth();
+	  stretchedToHeight = ctxt.getStretchToHeight();
+	  stretchedToDepth = ctxt.getStretchToDepth();
+	}
+      else
+	{
+	  unstretchedArea = getArea();
+	  stretchedArea = nullptr;
+	}
+
       ctxt.pop();
 
       resetDirtyLayout();
@@ -230,6 +201,105 @@ MathMLOperatorElement::format(FormattingContext& ctxt)
   return getArea();
 }
 
+void
+MathMLOperatorElement::resolveProperties(TokenId form, const SmartPtr<MathMLOperatorDictionary>& dictionary)
+{
+  SmartPtr<AttributeSet> prefix;
+  SmartPtr<AttributeSet> infix;
+  SmartPtr<AttributeSet> postfix;
+
+  if (dictionary)
+    dictionary->search(GetRawContent(), prefix, infix, postfix);
+
+  SmartPtr<AttributeSet> defaults;
+  if      (form == T_PREFIX && prefix) defaults = prefix;
+  else if (form == T_INFIX && infix) defaults = infix;
+  else if (form == T_POSTFIX && postfix) defaults = postfix;
+  else if (infix) defaults = infix;
+  else if (postfix) defaults = postfix;
+  else if (prefix) defaults = prefix;
+  else defaults = nullptr;
+
+  // every operator attribute has a default value, hence the lookups
+  // below never fail
+  resolved.fence = ToBoolean(GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, fence, defaults));
+  resolved.separator = ToBoolean(GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, separator, defaults));
+  resolved.stretchy = ToBoolean(GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, stretchy, defaults));
+  resolved.symmetric = ToBoolean(GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, symmetric, defaults));
+  resolved.movableLimits = ToBoolean(GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, movablelimits, defaults));
+  resolved.accent = ToBoolean(GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, accent, defaults));
+  resolved.largeOp = ToBoolean(GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, largeop, defaults));
+  resolved.lSpace = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, lspace, defaults);
+  resolved.rSpace = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, rspace, defaults);
+  resolved.minSize = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, minsize, defaults);
+  resolved.maxSize = GET_OPERATOR_ATTRIBUTE_VALUE(MathML, Operator, maxsize, defaults);
+  assert(resolved.lSpace && resolved.rSpace && resolved.minSize && resolved.maxSize);
+
+  resolved.form = form;
+  resolved.dictionary = dictionary;
+  resolved.valid = true;
+}
+
+void
+MathMLOperatorElement::setAttribute(const SmartPtr<Attribute>& attr)
+{
+  // setting an attribute only dirties the layout, so the properties
+  // are resolved again here unless the value is the same
+  SmartPtr<Attribute> old = getAttribute(attr->getSignature());
+  if (!old || !old->equal(attr)) resolved.valid = false;
+  MathMLTokenElement::setAttribute(attr);
+}
+
+void
+MathMLOperatorElement::removeAttribute(const AttributeSignature& signature)
+{
+  if (getAttribute(signature)) resolved.valid = false;
+  MathMLTokenElement::removeAttribute(signature);
+}
+
+void
+MathMLOperatorElement::setDirtyStructure()
+{
+  resolved.valid = false;
+  MathMLTokenElement::setDirtyStructure();
+}
+
+void
+MathMLOperatorElement::setDirtyAttribute()
+{
+  resolved.valid = false;
+  MathMLTokenElement::setDirtyAttribute();
+}
+
+void
+MathMLOperatorElement::setFlagDown(Flags f)
+{
+  // attributes inherited from an ancestor may have changed
+  if (f == FDirtyAttributeD || f == FDirtyStructure) resolved.valid = false;
+  MathMLTokenElement::setFlagDown(f);
+}
+
+AreaRef
+MathMLOperatorElement::reuseUnstretchedArea()
+{
+  assert(!dirtyLayout() && unstretchedArea);
+  setArea(unstretchedArea);
+  return unstretchedArea;
+}
+
+AreaRef
+MathMLOperatorElement::reuseStretchedArea(const FormattingContext& ctxt)
+{
+  if (dirtyLayout() || !stretchedArea
+      || stretchedToWidth != ctxt.getStretchToWidth()
+      || stretchedToHeight != ctxt.getStretchToHeight()
+      || stretchedToDepth != ctxt.getStretchToDepth())
+    return nullptr;
+
+  setArea(stretchedArea);
+  return stretchedArea;
+}
+
 void
 MathMLOperatorElement::parseLimitValue(const SmartPtr<Value>& value,
 				       const FormattingContext& ctxt,
@@ -303,7 +373,7 @@ MathMLOperatorElement::inferOperatorForm()
 }
 
 SmartPtr<MathMLOperatorElement>
-MathMLOperatorElement::getCoreOperator()
+MathMLOperatorElement::computeCoreOperator()
 {
   return this;
 }
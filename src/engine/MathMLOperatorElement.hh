@@ -24,7 +24,9 @@
 #define __MathMLOperatorElement_hh__
 
 #include "MathMLEmbellishment.hh"
+#include "MathMLOperatorDictionary.hh"
 #include "MathMLTokenElement.hh"
+#include "Value.hh"
 #include "token.hh"
 
 class MathMLOperatorElement
@@ -35,11 +37,19 @@ protected:
   virtual ~MathMLOperatorElement();
 
 public:
+  DECLARE_KIND(MathMLOperatorElement, Node, KMathMLOperatorElement, KMathMLOperatorElement)
+
   static SmartPtr<MathMLOperatorElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLOperatorElement(view); }
 
   virtual AreaRef format(class FormattingContext&);
 
+  virtual void setAttribute(const SmartPtr<class Attribute>&);
+  virtual void removeAttribute(const struct AttributeSignature&);
+  virtual void setDirtyStructure(void);
+  virtual void setDirtyAttribute(void);
+  virtual void setFlagDown(Flags);
+
   bool         IsStretchy(void) const { return stretchy; }
   bool         IsAccent(void) const { return accent; }
   bool         ForcedFence(void) const { return forcedFence; }
@@ -56,10 +66,17 @@ public:
   scaled       getLeftPadding(void) const { return lSpace; }
   scaled       getRightPadding(void) const { return rSpace; }
 
-  virtual SmartPtr<MathMLOperatorElement> getCoreOperator(void);
+  // The operator keeps the areas it was last formatted to at its
+  // natural size and stretched, along with the extent it was stretched
+  // for, so that a row can switch between them without formatting the
+  // operator again as long as the operator is not dirty
+  bool isStretched(void) const { return stretchedArea && getArea() == stretchedArea; }
+  AreaRef reuseUnstretchedArea(void);
+  AreaRef reuseStretchedArea(const class FormattingContext&);
 
 private:
   TokenId inferOperatorForm(void);
+  void resolveProperties(TokenId, const SmartPtr<MathMLOperatorDictionary>&);
   SmartPtr<Value> getOperatorAttributeValue(const struct AttributeSignature&, const SmartPtr<class AttributeSet>&) const;
   void parseLimitValue(const SmartPtr<Value>&, const class FormattingContext&, float&, scaled&);
 
@@ -75,6 +92,40 @@ private:
   bool accent;
   scaled lSpace;
   scaled rSpace;
+
+  // Operator properties resolved against the attributes of the element
+  // and the dictionary entry for its content. They are resolved again
+  // only when the content, the attributes, the form or the dictionary
+  // change. Lengths are kept unevaluated since they depend on the
+  // formatting context
+  struct ResolvedProperties
+  {
+    ResolvedProperties(void) : valid(false), form(T__NOTVALID) { }
+
+    bool valid;
+    TokenId form;
+    SmartPtr<MathMLOperatorDictionary> dictionary;
+    bool fence;
+    bool separator;
+    bool stretchy;
+    bool symmetric;
+    bool movableLimits;
+    bool accent;
+    bool largeOp;
+    SmartPtr<Value> lSpace;
+    SmartPtr<Value> rSpace;
+    SmartPtr<Value> minSize;
+    SmartPtr<Value> maxSize;
+  } resolved;
+
+  AreaRef unstretchedArea;
+  AreaRef stretchedArea;
+  scaled stretchedToWidth;
+  scaled stretchedToHeight;
+  scaled stretchedToDepth;
+
+protected:
+  virtual SmartPtr<MathMLOperatorElement> computeCoreOperator(void);
 };
 
 #endif // __MathMLOperatorElement_hh__
@@ -35,7 +35,7 @@
 #include "MathGraphicDevice.hh"
 
 MathMLPaddedElement::MathMLPaddedElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLNormalizingContainerElement(context)
+  : MathMLNormalizingContainerElement(context, KMathMLPaddedElement)
 { }
 
 MathMLPaddedElement::~MathMLPaddedElement()
@@ -46,6 +46,7 @@ MathMLPaddedElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
 
       if (AreaRef childArea = getChild() ? getChild()->format(ctxt) : nullptr)
@@ -201,7 +202,7 @@ MathMLPaddedElement::evalLengthDimension(const FormattingContext& ctxt,
 }
 
 SmartPtr<MathMLOperatorElement>
-MathMLPaddedElement::getCoreOperator()
+MathMLPaddedElement::computeCoreOperator()
 {
   return getChild() ? getChild()->getCoreOperator() : nullptr;
 }
@@ -34,11 +34,12 @@ protected:
   virtual ~MathMLPaddedElement();
 
 public:
+  DECLARE_KIND(MathMLPaddedElement, Node, KMathMLPaddedElement, KMathMLPaddedElement)
+
   static SmartPtr<MathMLPaddedElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLPaddedElement(view); }
 
   virtual AreaRef format(class FormattingContext&);
-  virtual SmartPtr<class MathMLOperatorElement> getCoreOperator(void);
 
 private:
   struct LengthDimension
@@ -67,6 +68,9 @@ private:
   LengthDimension depth;
 
   scaled lSpaceE; // evaluated
+
+protected:
+  virtual SmartPtr<class MathMLOperatorElement> computeCoreOperator(void);
 };
 
 #endif // __MathMLPaddedElement_hh__
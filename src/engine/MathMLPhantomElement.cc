@@ -31,14 +31,14 @@
 #include "MathGraphicDevice.hh"
 
 MathMLPhantomElement::MathMLPhantomElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLNormalizingContainerElement(context)
+  : MathMLNormalizingContainerElement(context, KMathMLPhantomElement)
 { }
 
 MathMLPhantomElement::~MathMLPhantomElement()
 { }
 
 bool
-MathMLPhantomElement::IsSpaceLike() const
+MathMLPhantomElement::computeSpaceLike() const
 {
   assert(getChild());
   return getChild()->IsSpaceLike();
@@ -49,6 +49,7 @@ MathMLPhantomElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
       AreaRef res = getChild() ? getChild()->format(ctxt) : nullptr;
       
@@ -66,7 +67,7 @@ MathMLPhantomElement::format(FormattingContext& ctxt)
 }
 
 SmartPtr<MathMLOperatorElement>
-MathMLPhantomElement::getCoreOperator()
+MathMLPhantomElement::computeCoreOperator()
 {
   return getChild() ? getChild()->getCoreOperator() : nullptr;
 }
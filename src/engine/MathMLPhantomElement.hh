@@ -30,6 +30,8 @@ class MathMLPhantomElement
   : public MathMLNormalizingContainerElement, public MathMLEmbellishment
 {
 public:
+  DECLARE_KIND(MathMLPhantomElement, Node, KMathMLPhantomElement, KMathMLPhantomElement)
+
   MathMLPhantomElement(const SmartPtr<class MathMLNamespaceContext>&);
   virtual ~MathMLPhantomElement();
 
@@ -39,8 +41,9 @@ public:
 
   virtual AreaRef format(class FormattingContext&);
 
-  virtual bool IsSpaceLike(void) const;
-  virtual SmartPtr<class MathMLOperatorElement> getCoreOperator(void);
+protected:
+  virtual bool computeSpaceLike(void) const;
+  virtual SmartPtr<class MathMLOperatorElement> computeCoreOperator(void);
 };
 
 #endif // __MathMLPhantomElement_hh__
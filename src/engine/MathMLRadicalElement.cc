@@ -29,7 +29,7 @@
 #include "MathGraphicDevice.hh"
 
 MathMLRadicalElement::MathMLRadicalElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLContainerElement(context)
+  : MathMLContainerElement(context, KMathMLRadicalElement)
 { }
 
 MathMLRadicalElement::~MathMLRadicalElement()
@@ -40,6 +40,7 @@ MathMLRadicalElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
 
       AreaRef baseArea = getBase()->format(ctxt);
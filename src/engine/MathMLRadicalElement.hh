@@ -33,6 +33,8 @@ protected:
   virtual ~MathMLRadicalElement();
 
 public:
+  DECLARE_KIND(MathMLRadicalElement, Node, KMathMLRadicalElement, KMathMLRadicalElement)
+
   static SmartPtr<MathMLRadicalElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLRadicalElement(view); }
 
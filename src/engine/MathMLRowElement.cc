@@ -37,8 +37,11 @@
 #include "FormattingContext.hh"
 #include "MathGraphicDevice.hh"
 
-MathMLRowElement::MathMLRowElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLLinearContainerElement(context)
+MathMLRowElement::MathMLRowElement(const SmartPtr<class MathMLNamespaceContext>& context, Kind kind)
+  : MathMLLinearContainerElement(context, kind)
+  , nonSpaceLikeCount(0)
+  , firstNonSpaceLike(0)
+  , lastNonSpaceLike(0)
 { }
 
 MathMLRowElement::~MathMLRowElement()
@@ -55,6 +58,7 @@ MathMLRowElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
 
       bool stretchy = false;
@@ -66,11 +70,26 @@ MathMLRowElement::format(FormattingContext& ctxt)
 	if (elem)
 	  {
 	    SmartPtr<MathMLOperatorElement> coreOp = elem->getCoreOperatorTop();
-	    /* if we have an operator we must force reformatting cause we want to
-	     * get the minimum size operator
+	    /* the extent of the row is computed with operators at their
+	     * minimum size. A stretched operator that has not changed
+	     * provides it without formatting, otherwise it has to be
+	     * formatted again
 	     */
-	    if (coreOp) elem->setDirtyLayout();
-	    if (AreaRef elemArea = elem->format(ctxt))
+	    AreaRef elemArea;
+	    if (coreOp && coreOp->isStretched())
+	      {
+		if (elem == coreOp && !coreOp->dirtyLayout())
+		  elemArea = coreOp->reuseUnstretchedArea();
+		else
+		  {
+		    coreOp->setDirtyLayout();
+		    elemArea = elem->format(ctxt);
+		  }
+	      }
+	    else
+	      elemArea = elem->format(ctxt);
+
+	    if (elemArea)
 	      {
 		row.push_back(elemArea);
 		// WARNING: we can check for IsStretchy only *after* format because it is
@@ -97,8 +116,12 @@ MathMLRowElement::format(FormattingContext& ctxt)
 	      {
 		const int i = op - erow.begin();
 		ctxt.setStretchOperator(*op);
-		(*op)->setDirtyLayout();
-		row[i] = getChild(i)->format(ctxt);
+		// an operator stretched to the same extent is reused
+		if (getChild(i) != *op || !(row[i] = (*op)->reuseStretchedArea(ctxt)))
+		  {
+		    (*op)->setDirtyLayout();
+		    row[i] = getChild(i)->format(ctxt);
+		  }
 	      }
 	  ctxt.setStretchOperator(nullptr);
 
@@ -117,10 +140,19 @@ MathMLRowElement::format(FormattingContext& ctxt)
 }
 
 bool
-MathMLRowElement::IsSpaceLike() const
+MathMLRowElement::computeSpaceLike() const
 {
-  return std::find_if(content.begin(), content.end(),
-		      std::not1(IsSpaceLikePredicate())) == content.end();
+  nonSpaceLikeCount = 0;
+  firstNonSpaceLike = lastNonSpaceLike = 0;
+  for (const auto & elem : content)
+    if (elem && !elem->IsSpaceLike())
+      {
+	if (!firstNonSpaceLike) firstNonSpaceLike = elem;
+	lastNonSpaceLike = elem;
+	nonSpaceLikeCount++;
+      }
+
+  return nonSpaceLikeCount == 0;
 }
 
 TokenId
@@ -128,37 +160,27 @@ MathMLRowElement::GetOperatorForm(const SmartPtr<MathMLElement>& eOp) const
 {
   assert(eOp);
 
+  // make sure the non space-like children have been scanned
+  IsSpaceLike();
+
   TokenId res = T_INFIX;
 
-  unsigned rowLength = 0;
-  unsigned position  = 0;
-  for (const auto & elem : content)
-    if (elem && !elem->IsSpaceLike())
-      {
-	if (elem == eOp) position = rowLength;
-	rowLength++;
-      }
-    
-  if (rowLength > 1) 
+  if (nonSpaceLikeCount > 1)
     {
-      if (position == 0) res = T_PREFIX;
-      else if (position == rowLength - 1) res = T_POSTFIX;
+      // as before, an operator that is not among the non space-like
+      // children of the row is treated as the first one
+      if (eOp == lastNonSpaceLike) res = T_POSTFIX;
+      else if (eOp == firstNonSpaceLike || eOp->IsSpaceLike() ||
+	       static_cast<Element*>(eOp->getParent()) != this) res = T_PREFIX;
     }
 
   return res;
 }
 
 SmartPtr<class MathMLOperatorElement>
-MathMLRowElement::getCoreOperator()
+MathMLRowElement::computeCoreOperator()
 {
-  SmartPtr<MathMLElement> candidate = nullptr;
-
-  for (const auto & elem : content)
-    if (elem && !elem->IsSpaceLike())
-      {
-      if (!candidate) candidate = elem;
-      else return nullptr;
-      }
+  if (IsSpaceLike() || nonSpaceLikeCount != 1) return nullptr;
 
-  return candidate ? candidate->getCoreOperator() : nullptr;
+  return const_cast<MathMLElement*>(firstNonSpaceLike)->getCoreOperator();
 }
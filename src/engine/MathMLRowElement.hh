@@ -31,18 +31,29 @@ class MathMLRowElement
   : public MathMLLinearContainerElement, public MathMLEmbellishment
 {
 protected:
-  MathMLRowElement(const SmartPtr<class MathMLNamespaceContext>&);
+  MathMLRowElement(const SmartPtr<class MathMLNamespaceContext>&, Kind = KMathMLRowElement);
   virtual ~MathMLRowElement();
 
 public:
+  DECLARE_KIND(MathMLRowElement, Node, KMathMLRowElement, KMathMLInferredRowElement)
+
   static SmartPtr<MathMLRowElement> create(const SmartPtr<class MathMLNamespaceContext>& view);
 
   virtual AreaRef format(class FormattingContext&);
 
-  virtual bool IsSpaceLike(void) const;
-
   TokenId GetOperatorForm(const SmartPtr<MathMLElement>&) const;
-  virtual SmartPtr<class MathMLOperatorElement> getCoreOperator(void);
+
+protected:
+  virtual bool computeSpaceLike(void) const;
+  virtual SmartPtr<class MathMLOperatorElement> computeCoreOperator(void);
+
+private:
+  // the form of an operator only depends on whether it is the first or
+  // the last non space-like child of the row. They are found by the
+  // same scan that decides whether the row itself is space-like
+  mutable unsigned nonSpaceLikeCount;
+  mutable const MathMLElement* firstNonSpaceLike;
+  mutable const MathMLElement* lastNonSpaceLike;
 };
 
 #endif // __MathMLRowElement_hh__
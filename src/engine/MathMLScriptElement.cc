@@ -32,7 +32,7 @@
 #include "MathMLAttributeSignatures.hh"
 
 MathMLScriptElement::MathMLScriptElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLContainerElement(context)
+  : MathMLContainerElement(context, KMathMLScriptElement)
 { }
 
 MathMLScriptElement::~MathMLScriptElement()
@@ -43,6 +43,7 @@ MathMLScriptElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
 
       assert(getBase());
@@ -91,7 +92,7 @@ MathMLScriptElement::format(FormattingContext& ctxt)
 }
 
 SmartPtr<class MathMLOperatorElement>
-MathMLScriptElement::getCoreOperator()
+MathMLScriptElement::computeCoreOperator()
 {
   return getBase() ? getBase()->getCoreOperator() : nullptr;
 }
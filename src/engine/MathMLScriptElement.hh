@@ -35,6 +35,8 @@ protected:
   virtual ~MathMLScriptElement();
 
 public:
+  DECLARE_KIND(MathMLScriptElement, Node, KMathMLScriptElement, KMathMLScriptElement)
+
   static SmartPtr<MathMLScriptElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLScriptElement(view); }
 
@@ -49,12 +51,14 @@ public:
 
   virtual void setFlagDown(Flags);
   virtual void resetFlagDown(Flags);
-  virtual SmartPtr<class MathMLOperatorElement> getCoreOperator(void);
 
 private:
   BinContainerTemplate<MathMLScriptElement,MathMLElement> base;
   BinContainerTemplate<MathMLScriptElement,MathMLElement> subScript;
   BinContainerTemplate<MathMLScriptElement,MathMLElement> superScript;
+
+protected:
+  virtual SmartPtr<class MathMLOperatorElement> computeCoreOperator(void);
 };
 
 #endif // __MathMLScriptElement_hh__
@@ -33,7 +33,7 @@
 #include "MathGraphicDevice.hh"
 
 MathMLSpaceElement::MathMLSpaceElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLElement(context)
+  : MathMLElement(context, KMathMLSpaceElement)
 {
   breakability = T_AUTO;
 }
@@ -46,6 +46,7 @@ MathMLSpaceElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
 
       scaled width;
@@ -98,7 +99,7 @@ MathMLSpaceElement::IsSpace() const
 }
 
 bool
-MathMLSpaceElement::IsSpaceLike() const
+MathMLSpaceElement::computeSpaceLike() const
 {
   return true;
 }
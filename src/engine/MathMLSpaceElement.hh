@@ -33,19 +33,23 @@ protected:
   virtual ~MathMLSpaceElement();
 
 public:
+  DECLARE_KIND(MathMLSpaceElement, Node, KMathMLSpaceElement, KMathMLSpaceElement)
+
   static SmartPtr<MathMLSpaceElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLSpaceElement(view); }
 
   virtual AreaRef format(class FormattingContext&);
 
   virtual bool    IsSpace(void) const;
-  virtual bool    IsSpaceLike(void) const;
   TokenId         GetBreakability(void) const { return breakability; }
 
 private:
   bool    lineBreak;
   bool    autoLineBreak; // valid if lineBreaking == true
   TokenId breakability; // valid if auto == false
+
+protected:
+  virtual bool computeSpaceLike(void) const;
 };
 
 #endif // __MathMLSpaceElement_hh__
@@ -27,6 +27,7 @@
 #include "MathMLSpaceNode.hh"
 
 MathMLSpaceNode::MathMLSpaceNode(int s)
+  : MathMLTextNode(KMathMLSpaceNode)
 { }
 
 MathMLSpaceNode::~MathMLSpaceNode()
@@ -32,6 +32,8 @@ protected:
   virtual ~MathMLSpaceNode();
 
 public:
+  DECLARE_KIND(MathMLSpaceNode, Node, KMathMLSpaceNode, KMathMLSpaceNode)
+
   static SmartPtr<MathMLSpaceNode> create(int s = 0)
   { return SmartPtr<MathMLSpaceNode>(new MathMLSpaceNode(s)); }
 
@@ -30,7 +30,7 @@
 #include "MathMLAttributeSignatures.hh"
 
 MathMLStringLitElement::MathMLStringLitElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLTokenElement(context)
+  : MathMLTokenElement(context, KMathMLStringLitElement)
 {
   setupDone = false;
 }
@@ -32,6 +32,8 @@ protected:
   virtual ~MathMLStringLitElement();
 
 public:
+  DECLARE_KIND(MathMLStringLitElement, Node, KMathMLStringLitElement, KMathMLStringLitElement)
+
   static SmartPtr<MathMLStringLitElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLStringLitElement(view); }
 
@@ -36,7 +36,7 @@ isCombining(Char32 ch)
 }
 
 MathMLStringNode::MathMLStringNode(const String& c)
-  : content(c)
+  : MathMLTextNode(KMathMLStringNode), content(c)
 { }
 
 MathMLStringNode::~MathMLStringNode()
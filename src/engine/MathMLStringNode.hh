@@ -33,6 +33,8 @@ protected:
   virtual ~MathMLStringNode();
 
 public:
+  DECLARE_KIND(MathMLStringNode, Node, KMathMLStringNode, KMathMLStringNode)
+
   static SmartPtr<MathMLStringNode> create(const String& s)
   { return new MathMLStringNode(s); }
 
@@ -34,7 +34,7 @@
 #include "MathGraphicDevice.hh"
 
 MathMLStyleElement::MathMLStyleElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLNormalizingContainerElement(context)
+  : MathMLNormalizingContainerElement(context, KMathMLStyleElement)
 { }
 
 MathMLStyleElement::~MathMLStyleElement()
@@ -45,6 +45,7 @@ MathMLStyleElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
 
       if (SmartPtr<Value> value = GET_ATTRIBUTE_VALUE(MathML, Style, displaystyle))
@@ -152,7 +153,7 @@ MathMLStyleElement::format(FormattingContext& ctxt)
 }
 
 bool
-MathMLStyleElement::IsSpaceLike() const
+MathMLStyleElement::computeSpaceLike() const
 {
   assert(getChild());
   return getChild()->IsSpaceLike();
@@ -165,7 +166,7 @@ MathMLStyleElement::setDirtyAttribute()
 }
 
 SmartPtr<MathMLOperatorElement>
-MathMLStyleElement::getCoreOperator()
+MathMLStyleElement::computeCoreOperator()
 {
   return getChild() ? getChild()->getCoreOperator() : nullptr;
 }
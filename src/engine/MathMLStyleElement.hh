@@ -30,6 +30,8 @@ class MathMLStyleElement
   : public MathMLNormalizingContainerElement, public MathMLEmbellishment
 {
 public:
+  DECLARE_KIND(MathMLStyleElement, Node, KMathMLStyleElement, KMathMLStyleElement)
+
   MathMLStyleElement(const SmartPtr<class MathMLNamespaceContext>&);
   virtual ~MathMLStyleElement();
 
@@ -39,9 +41,11 @@ public:
 
   virtual AreaRef format(class FormattingContext&);
 
-  virtual bool IsSpaceLike(void) const;
   virtual void setDirtyAttribute(void);
-  virtual SmartPtr<class MathMLOperatorElement> getCoreOperator(void);
+
+protected:
+  virtual bool computeSpaceLike(void) const;
+  virtual SmartPtr<class MathMLOperatorElement> computeCoreOperator(void);
 };
 
 #endif // __MathMLStyleElement_hh__
@@ -34,7 +34,7 @@
 #include "MathMLAttributeSignatures.hh"
 
 MathMLTableCellElement::MathMLTableCellElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLNormalizingContainerElement(context)
+  : MathMLNormalizingContainerElement(context, KMathMLTableCellElement)
 {
   rowIndex = 0;
   columnIndex = 0;
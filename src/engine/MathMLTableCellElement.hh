@@ -33,6 +33,8 @@ protected:
   virtual ~MathMLTableCellElement();
 
 public:
+  DECLARE_KIND(MathMLTableCellElement, Node, KMathMLTableCellElement, KMathMLTableCellElement)
+
   static SmartPtr<MathMLTableCellElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLTableCellElement(view); }
 
@@ -35,7 +35,7 @@
 #include "defs.h"
 
 MathMLTableElement::MathMLTableElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLContainerElement(context)
+  : MathMLContainerElement(context, KMathMLTableElement)
 { }
 
 MathMLTableElement::~MathMLTableElement()
@@ -98,6 +98,7 @@ MathMLTableElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
       //std::cerr << "formatting table 1" << std::endl;
       if (!tableFormatter)
@@ -34,6 +34,8 @@ protected:
   virtual ~MathMLTableElement();
 
 public:
+  DECLARE_KIND(MathMLTableElement, Node, KMathMLTableElement, KMathMLTableElement)
+
   static SmartPtr<MathMLTableElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLTableElement(view); }
 
@@ -33,8 +33,8 @@
 #include "MathMLTableCellElement.hh"
 #include "MathMLAttributeSignatures.hh"
 
-MathMLTableRowElement::MathMLTableRowElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLLinearContainerElement(context)
+MathMLTableRowElement::MathMLTableRowElement(const SmartPtr<class MathMLNamespaceContext>& context, Kind kind)
+  : MathMLLinearContainerElement(context, kind)
 {
   rowIndex = 0;
 }
@@ -29,10 +29,12 @@ class MathMLTableRowElement
   : public MathMLLinearContainerElement
 {
 protected:
-  MathMLTableRowElement(const SmartPtr<class MathMLNamespaceContext>&);
+  MathMLTableRowElement(const SmartPtr<class MathMLNamespaceContext>&, Kind = KMathMLTableRowElement);
   virtual ~MathMLTableRowElement();
 
 public:
+  DECLARE_KIND(MathMLTableRowElement, Node, KMathMLTableRowElement, KMathMLLabeledTableRowElement)
+
   static SmartPtr<MathMLTableRowElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLTableRowElement(view); }
 
@@ -25,14 +25,14 @@
 #include "MathMLTextElement.hh"
 
 MathMLTextElement::MathMLTextElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLTokenElement(context)
+  : MathMLTokenElement(context, KMathMLTextElement)
 { }
 
 MathMLTextElement::~MathMLTextElement()
 { }
 
 bool
-MathMLTextElement::IsSpaceLike(void) const
+MathMLTextElement::computeSpaceLike(void) const
 {
   return true;
 }
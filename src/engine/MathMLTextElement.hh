@@ -32,10 +32,13 @@ protected:
   virtual ~MathMLTextElement();
 
 public:
+  DECLARE_KIND(MathMLTextElement, Node, KMathMLTextElement, KMathMLTextElement)
+
   static SmartPtr<MathMLTextElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLTextElement(view); }
 
-  virtual bool IsSpaceLike(void) const;
+protected:
+  virtual bool computeSpaceLike(void) const;
 };
 
 #endif // __MathMLTextElement_hh__
@@ -26,7 +26,7 @@
 
 #include "MathMLTextNode.hh"
 
-MathMLTextNode::MathMLTextNode()
+MathMLTextNode::MathMLTextNode(Kind kind) : MathMLNode(kind)
 { }
 
 MathMLTextNode::~MathMLTextNode()
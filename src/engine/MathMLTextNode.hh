@@ -30,10 +30,12 @@
 class MathMLTextNode : public MathMLNode
 {
 protected:
-  MathMLTextNode(void);
+  MathMLTextNode(Kind);
   virtual ~MathMLTextNode();
 
 public:
+  DECLARE_KIND(MathMLTextNode, Node, KFirstMathMLNode, KLastMathMLNode)
+
   virtual AreaRef format(class FormattingContext&) = 0;
 
   virtual String   GetRawContent(void) const { return String(); }
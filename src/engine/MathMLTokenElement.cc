@@ -42,8 +42,8 @@
 #include "traverseAux.hh"
 #include "MathMLAttributeSignatures.hh"
 
-MathMLTokenElement::MathMLTokenElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLElement(context)
+MathMLTokenElement::MathMLTokenElement(const SmartPtr<class MathMLNamespaceContext>& context, Kind kind)
+  : MathMLElement(context, kind)
 { }
 
 MathMLTokenElement::~MathMLTokenElement()
@@ -78,11 +78,11 @@ MathMLTokenElement::formatAux(FormattingContext& ctxt)
   const unsigned logicalContentLength = GetLogicalContentLength();
   if (SmartPtr<Value> value = GET_ATTRIBUTE_VALUE(MathML, Token, mathvariant))
     ctxt.setVariant(toMathVariant(value));
-  else if (is_a<MathMLIdentifierElement>(SmartPtr<MathMLTokenElement>(this)) && logicalContentLength == 1)
+  else if (getKind() == KMathMLIdentifierElement && logicalContentLength == 1)
     ctxt.setVariant(ITALIC_VARIANT);
 
-  if (is_a<MathMLTextElement>(SmartPtr<MathMLTokenElement>(this)) ||
-      (is_a<MathMLIdentifierElement>(SmartPtr<MathMLTokenElement>(this)) && logicalContentLength > 1))
+  if (getKind() == KMathMLTextElement ||
+      (getKind() == KMathMLIdentifierElement && logicalContentLength > 1))
     ctxt.setMathMode(false);
 
   if (SmartPtr<Value> value = GET_ATTRIBUTE_VALUE(MathML, Token, mathcolor))
@@ -123,6 +123,7 @@ MathMLTokenElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
       setArea(ctxt.MGD()->wrapper(ctxt, formatAux(ctxt)));
       ctxt.pop();
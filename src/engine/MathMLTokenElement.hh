@@ -32,10 +32,12 @@
 class MathMLTokenElement : public MathMLElement
 {
 protected:
-  MathMLTokenElement(const SmartPtr<class MathMLNamespaceContext>&);
+  MathMLTokenElement(const SmartPtr<class MathMLNamespaceContext>&, Kind);
   virtual ~MathMLTokenElement();
 
 public:
+  DECLARE_KIND(MathMLTokenElement, Node, KFirstMathMLTokenElement, KLastMathMLTokenElement)
+
   unsigned getSize(void) const { return content.getSize(); }
   void setSize(unsigned i) { content.setSize(this, i); }
   SmartPtr<class MathMLTextNode> getChild(unsigned i) const { return content.getChild(i); }
@@ -34,7 +34,7 @@
 #include "MathMLAttributeSignatures.hh"
 
 MathMLUnderOverElement::MathMLUnderOverElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLContainerElement(context)
+  : MathMLContainerElement(context, KMathMLUnderOverElement)
 { }
 
 MathMLUnderOverElement::~MathMLUnderOverElement()
@@ -45,6 +45,7 @@ MathMLUnderOverElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       bool accent = false;
       bool accentUnder = false;
 
@@ -148,7 +149,7 @@ MathMLUnderOverElement::format(FormattingContext& ctxt)
 }
 
 SmartPtr<MathMLOperatorElement>
-MathMLUnderOverElement::getCoreOperator()
+MathMLUnderOverElement::computeCoreOperator()
 {
   return getBase() ? getBase()->getCoreOperator() : nullptr;
 }
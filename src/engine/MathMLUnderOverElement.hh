@@ -35,6 +35,8 @@ protected:
   virtual ~MathMLUnderOverElement();
 
 public:
+  DECLARE_KIND(MathMLUnderOverElement, Node, KMathMLUnderOverElement, KMathMLUnderOverElement)
+
   static SmartPtr<MathMLUnderOverElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLUnderOverElement(view); }
 
@@ -51,9 +53,9 @@ public:
   virtual void setFlagDown(Flags);
   virtual void resetFlagDown(Flags);
 
-  virtual SmartPtr<class MathMLOperatorElement> getCoreOperator(void);
-
 protected:
+  virtual SmartPtr<class MathMLOperatorElement> computeCoreOperator(void);
+
   bool   scriptize;
 
   bool   accentUnder;
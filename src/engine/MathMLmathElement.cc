@@ -31,7 +31,7 @@
 #include "MathMLAttributeSignatures.hh"
 
 MathMLmathElement::MathMLmathElement(const SmartPtr<class MathMLNamespaceContext>& context)
-  : MathMLNormalizingContainerElement(context)
+  : MathMLNormalizingContainerElement(context, KMathMLmathElement)
 { }
 
 MathMLmathElement::~MathMLmathElement()
@@ -42,6 +42,7 @@ MathMLmathElement::format(FormattingContext& ctxt)
 {
   if (dirtyLayout())
     {
+      ctxt.countFormattedElement();
       ctxt.push(this);
       ctxt.setMathMode(true);
       SmartPtr<Value> value = GET_ATTRIBUTE_VALUE(MathML, math, display);
@@ -32,6 +32,8 @@ protected:
   virtual ~MathMLmathElement();
 
 public:
+  DECLARE_KIND(MathMLmathElement, Node, KMathMLmathElement, KMathMLmathElement)
+
   static SmartPtr<MathMLmathElement> create(const SmartPtr<class MathMLNamespaceContext>& view)
   { return new MathMLmathElement(view); }
 
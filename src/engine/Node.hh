@@ -28,13 +28,81 @@
 
 class Node : public Object
 {
+public:
+  // the kinds of a class and of its subclasses are contiguous, see
+  // DECLARE_KIND in KindCast.hh
+  enum Kind
+    {
+      KNode,
+
+      KMathMLFunctionApplicationNode,
+      KMathMLGlyphNode,
+      KMathMLInvisibleTimesNode,
+      KMathMLMarkNode,
+      KMathMLSpaceNode,
+      KMathMLStringNode,
+
+      KElement,
+      KMathMLAlignGroupElement,
+      KMathMLAlignMarkElement,
+      KMathMLDummyElement,
+      KMathMLSpaceElement,
+      // token elements
+      KMathMLIdentifierElement,
+      KMathMLNumberElement,
+      KMathMLOperatorElement,
+      KMathMLStringLitElement,
+      KMathMLTextElement,
+      // container elements
+      KMathMLFractionElement,
+      KMathMLMultiScriptsElement,
+      KMathMLRadicalElement,
+      KMathMLScriptElement,
+      KMathMLTableElement,
+      KMathMLUnderOverElement,
+      // linear container elements
+      KMathMLActionElement,
+      KMathMLRowElement,
+      KMathMLInferredRowElement,
+      KMathMLTableRowElement,
+      KMathMLLabeledTableRowElement,
+      // normalizing container elements
+      KMathMLEncloseElement,
+      KMathMLErrorElement,
+      KMathMLPaddedElement,
+      KMathMLPhantomElement,
+      KMathMLStyleElement,
+      KMathMLTableCellElement,
+      KMathMLmathElement,
+
+      KFirstMathMLNode = KMathMLFunctionApplicationNode,
+      KLastMathMLNode = KMathMLStringNode,
+      KFirstElement = KElement,
+      KLastElement = KMathMLmathElement,
+      KFirstMathMLElement = KMathMLAlignGroupElement,
+      KLastMathMLElement = KMathMLmathElement,
+      KFirstMathMLTokenElement = KMathMLIdentifierElement,
+      KLastMathMLTokenElement = KMathMLTextElement,
+      KFirstMathMLContainerElement = KMathMLFractionElement,
+      KLastMathMLContainerElement = KMathMLmathElement,
+      KFirstMathMLLinearContainerElement = KMathMLActionElement,
+      KLastMathMLLinearContainerElement = KMathMLLabeledTableRowElement,
+      KFirstMathMLBinContainerElement = KMathMLEncloseElement,
+      KLastMathMLBinContainerElement = KMathMLmathElement
+    };
+
 protected:
-  Node(void) { }
+  Node(Kind k = KNode) : kind(k) { }
   virtual ~Node();
 
 public:
   static bool hasParentLink(void) { return false; }
   static void setParent(Node*, const SmartPtr<class Element>&) { }
+
+  Kind getKind(void) const { return kind; }
+
+private:
+  const Kind kind;
 };
 
 #endif // __Node_hh__
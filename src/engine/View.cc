@@ -32,11 +32,14 @@
 #include "MathMLOperatorDictionary.hh"
 #include "AreaId.hh"
 #include "AbstractLogger.hh"
+#include "AreaArena.hh"
 #include "FormattingContext.hh"
 #include "MathGraphicDevice.hh"
+#include "RenderingContext.hh"
+#include "SpatialIndex.hh"
 
 View::View(const SmartPtr<AbstractLogger>& l)
-  : logger(l), defaultFontSize(DEFAULT_FONT_SIZE), freezeCounter(0)
+  : logger(l), defaultFontSize(DEFAULT_FONT_SIZE), freezeCounter(0), useSpatialIndex(false), useAreaArena(false), fullLayout(true), formattedElementCount(0)
 { }
 
 View::~View()
@@ -103,11 +106,23 @@ View::formatElement(const SmartPtr<Element>& elem) const
       ctxt.setSize(l);
       ctxt.setActualSize(ctxt.getSize());
       ctxt.setAvailableWidth(getAvailableWidth());
+      const AreaAllocationStats before = AreaArena::getStats();
       Clock perf;
       perf.Start();
-      elem->format(ctxt);
+      {
+        // the arena of the previous full pass is released as soon as
+        // the new tree no longer shares any of its areas
+        AreaArena::Scope scope((useAreaArena && fullLayout) ? AreaArena::create() : nullptr);
+        elem->format(ctxt);
+      }
+      fullLayout = false;
       perf.Stop();
-      getLogger()->out(LOG_INFO, "formatting time: %dms", perf());
+      formattedElementCount = ctxt.getFormattedElementCount();
+      const AreaAllocationStats after = AreaArena::getStats();
+      getLogger()->out(LOG_INFO, "formatting time: %dms (%u elements formatted)", perf(), formattedElementCount);
+      getLogger()->out(LOG_INFO, "allocated areas: %lu on the heap, %lu in the arena (%lu bytes)",
+                       after.heap - before.heap, after.arena - before.arena,
+                       after.arenaBytes - before.arenaBytes);
     }
 
   return elem->getArea();
@@ -125,7 +140,9 @@ View::getRootElement() const
       Clock perf;
 	
       perf.Start();
+      const SmartPtr<Element> oldRoot = rootElement;
       rootElement = builder->getRootElement();
+      if (rootElement != oldRoot) fullLayout = true;
       perf.Stop();
 
       getLogger()->out(LOG_INFO, "build time: %dms", perf());
@@ -138,6 +155,8 @@ void
 View::resetRootElement()
 {
   rootElement = nullptr;
+  spatialIndex = nullptr;
+  fullLayout = true;
 }
 
 AreaRef
@@ -153,13 +172,33 @@ View::getBoundingBox() const
     return BoundingBox();
 }
 
+bool
+View::searchByCoords(const AreaRef& rootArea, AreaId& id, const scaled& x, const scaled& y) const
+{
+  if (!useSpatialIndex)
+    return rootArea->searchByCoords(id, x, y);
+
+  // areas are never modified after formatting, hence a different
+  // root area is the sign that the index is out of date
+  if (!spatialIndex || spatialIndex->getRootArea() != rootArea)
+    {
+      Clock perf;
+      perf.Start();
+      spatialIndex = SpatialIndex::create(rootArea);
+      perf.Stop();
+      getLogger()->out(LOG_INFO, "spatial index time: %dms (%d entries)", perf(), spatialIndex->getEntryCount());
+    }
+
+  return spatialIndex->searchByCoords(id, x, y);
+}
+
 SmartPtr<Element>
 View::getElementAt(const scaled& x, const scaled& y, Point* elemOrigin, BoundingBox* elemBox) const
 {
   if (AreaRef rootArea = getRootArea())
     {
       AreaId deepId(rootArea);
-      if (rootArea->searchByCoords(deepId, x, y))
+      if (searchByCoords(rootArea, deepId, x, y))
 	for (int i = deepId.size(); i >= 0; i--)
 	  {
 	    AreaRef area = deepId.getArea(i);
@@ -232,7 +271,7 @@ View::getCharAt(const scaled& x, const scaled& y, CharIndex& index, Point* charO
   if (AreaRef rootArea = getRootArea())
     {
       AreaId deepId(rootArea);
-      if (rootArea->searchByCoords(deepId, x, y))
+      if (searchByCoords(rootArea, deepId, x, y))
 	for (int i = deepId.size(); i >= 0; i--)
 	  {
 	    AreaRef area = deepId.getArea(i);
@@ -325,12 +364,22 @@ View::render(RenderingContext& ctxt, const scaled& x, const scaled& y) const
 
       // Basically (x, y) are the coordinates of the origin
       rootArea->render(ctxt, x, y);
+      ctxt.flush();
 
       perf.Stop();
       getLogger()->out(LOG_INFO, "rendering time: %dms", perf());
     }
 }
 
+void
+View::render(RenderingContext& ctxt, const scaled& x, const scaled& y, const Rectangle& visible) const
+{
+  // one em is enough for the ink that overhangs the box of a glyph
+  ctxt.setClipRectangle(visible, scaled(static_cast<int>(getDefaultFontSize())));
+  render(ctxt, x, y);
+  ctxt.resetClipRectangle();
+}
+
 void
 View::setDirtyLayout() const
 {
@@ -338,6 +387,7 @@ View::setDirtyLayout() const
     {
       //elem->setDirtyAttributeD();
       elem->setDirtyLayoutD();	  
+      fullLayout = true;
     }
 }
 
@@ -352,6 +402,13 @@ View::setDefaultFontSize(unsigned size)
     }
 }
 
+void
+View::setUseSpatialIndex(bool b)
+{
+  useSpatialIndex = b;
+  if (!useSpatialIndex) spatialIndex = nullptr;
+}
+
 void
 View::setAvailableWidth(const scaled& width)
 {
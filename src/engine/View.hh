@@ -76,6 +76,8 @@ public:
   { return getCharExtents(elem, index, nullptr, &b); }
 
   void render(class RenderingContext&, const scaled&, const scaled&) const;
+  // render only the subtrees whose box intersects the given rectangle
+  void render(class RenderingContext&, const scaled&, const scaled&, const struct Rectangle&) const;
 
   unsigned getDefaultFontSize(void) const { return defaultFontSize; }
   void setDefaultFontSize(unsigned);
@@ -83,9 +85,25 @@ public:
   scaled getAvailableWidth(void) const { return availableWidth; }
   void setAvailableWidth(const scaled&);
 
+  // when enabled, getElementAt and getCharAt search the formatted tree
+  // through a SpatialIndex that is rebuilt lazily after each relayout
+  bool getUseSpatialIndex(void) const { return useSpatialIndex; }
+  void setUseSpatialIndex(bool);
+  // when enabled, the areas created by a pass that lays out the whole
+  // tree again are allocated in an AreaArena of their own. Incremental
+  // passes allocate on the heap, so that the few areas they replace
+  // do not keep a new generation of chunks alive
+  bool getUseAreaArena(void) const { return useAreaArena; }
+  void setUseAreaArena(bool b) { useAreaArena = b; }
+  // the number of elements laid out again during the last layout
+  // pass. A local change should only format its ancestors and
+  // the operators whose stretch extent changed
+  unsigned getFormattedElementCount(void) const { return formattedElementCount; }
+
 protected:
   SmartPtr<const class Area> getRootArea(void) const;
   SmartPtr<const class Area> formatElement(const SmartPtr<class Element>&) const;
+  bool searchByCoords(const SmartPtr<const class Area>&, class AreaId&, const scaled&, const scaled&) const;
 
 private:
   mutable SmartPtr<class Element> rootElement;
@@ -96,6 +114,11 @@ private:
   unsigned defaultFontSize;
   unsigned freezeCounter;
   scaled availableWidth;
+  bool useSpatialIndex;
+  bool useAreaArena;
+  mutable bool fullLayout;
+  mutable unsigned formattedElementCount;
+  mutable SmartPtr<class SpatialIndex> spatialIndex;
 };
 
 #endif // __View_hh__
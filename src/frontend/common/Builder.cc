@@ -24,9 +24,11 @@
 
 #include "Builder.hh"
 #include "AbstractLogger.hh"
+#include "AttributeSet.hh"
 #include "MathMLNamespaceContext.hh"
 
 Builder::Builder()
+  : attributeSets(new AttributeSetPool)
 { }
 
 Builder::~Builder()
@@ -23,6 +23,8 @@
 #ifndef __Builder_hh__
 #define __Builder_hh__
 
+#include <memory>
+
 #include "Object.hh"
 #include "SmartPtr.hh"
 
@@ -42,9 +44,13 @@ public:
   void setMathMLNamespaceContext(const SmartPtr<class MathMLNamespaceContext>&);
   SmartPtr<class MathMLNamespaceContext> getMathMLNamespaceContext(void) const;
 
+  // the elements built by this builder share equal attribute sets
+  class AttributeSetPool& getAttributeSetPool(void) const { return *attributeSets; }
+
 protected:
   SmartPtr<class AbstractLogger> logger;
   SmartPtr<class MathMLNamespaceContext> mathmlContext;
+  std::unique_ptr<class AttributeSetPool> attributeSets;
 };
 
 #endif // __Builder_hh__
@@ -23,6 +23,7 @@
 #ifndef __TemplateBuilder_hh__
 #define __TemplateBuilder_hh__
 
+#include <mutex>
 #include <vector>
 
 #include "defs.h"
@@ -71,6 +72,7 @@ protected:
       {
 	ElementBuilder::begin(*this, el, elem);
 	ElementBuilder::refine(*this, el, elem);
+	elem->shareAttributes(this->getAttributeSetPool());
 	ElementBuilder::construct(*this, el, elem);
 	ElementBuilder::end(*this, el, elem);
       }
@@ -126,13 +128,11 @@ protected:
       { "",              0 }
     };
 
-    if (!mathmlMapInitialized)
-      {
+    // builders may be created concurrently by several threads
+    std::call_once(mathmlMapInitialized, [] {
 	for (unsigned i = 0; mathml_tab[i].update; i++)
 	  mathmlMap[mathml_tab[i].tag] = mathml_tab[i].update;
-
-	mathmlMapInitialized = true;
-      }
+      });
   }
 
   ////////////////////////////////////
@@ -965,6 +965,7 @@ protected:
 	    assert(elem);
 	    elem->resetDirtyStructure();
 	    elem->resetDirtyAttribute();
+	    elem->resetStructuralProperties();
 	    return elem;
 	  }
       }
@@ -1055,6 +1056,7 @@ protected:
     SmartPtr<MathMLElement> elem = MathMLDummyElement::create(this->getMathMLNamespaceContext());
     elem->resetDirtyStructure();
     elem->resetDirtyAttribute();
+    elem->resetStructuralProperties();
     return elem;
   }
 
@@ -1080,7 +1082,7 @@ private:
   typedef SmartPtr<class MathMLElement> (TemplateBuilder::* MathMLUpdateMethod)(const typename Model::Element&) const;
   typedef std::unordered_map<String, MathMLUpdateMethod, StringHash, StringEq> MathMLBuilderMap;
   static MathMLBuilderMap mathmlMap;
-  static bool mathmlMapInitialized;
+  static std::once_flag mathmlMapInitialized;
   mutable RefinementContext refinementContext;
 };
 
@@ -1088,6 +1090,6 @@ template <class Model, class Builder, class RefinementContext>
 typename TemplateBuilder<Model,Builder,RefinementContext>::MathMLBuilderMap TemplateBuilder<Model,Builder,RefinementContext>::mathmlMap;
 
 template <class Model, class Builder, class RefinementContext>
-bool TemplateBuilder<Model,Builder,RefinementContext>::mathmlMapInitialized = false;
+std::once_flag TemplateBuilder<Model,Builder,RefinementContext>::mathmlMapInitialized;
 
 #endif // __TemplateBuilder_hh__
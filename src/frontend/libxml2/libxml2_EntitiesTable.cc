@@ -23,6 +23,9 @@
 
 #include <config.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
 
 #include "libxml2_EntitiesTable.hh"
 
@@ -31,8 +34,31 @@ static const EntitiesTableEntry mathmlEntities[] = {
   { NULL, NULL }
 };
 
+static const size_t mathmlEntityCount = sizeof(mathmlEntities) / sizeof(mathmlEntities[0]) - 1;
+
 const EntitiesTableEntry*
 getMathMLEntities(void)
 {
   return mathmlEntities;
 }
+
+size_t
+getMathMLEntityCount(void)
+{
+  return mathmlEntityCount;
+}
+
+static bool
+entryNameLess(const EntitiesTableEntry& entry, const char* name)
+{
+  return strcmp(entry.name, name) < 0;
+}
+
+const EntitiesTableEntry*
+findMathMLEntity(const char* name)
+{
+  // dumpEntitiesTable emits the entries sorted by name
+  const EntitiesTableEntry* end = mathmlEntities + mathmlEntityCount;
+  const EntitiesTableEntry* entry = std::lower_bound(mathmlEntities, end, name, entryNameLess);
+  return (entry != end && strcmp(entry->name, name) == 0) ? entry : NULL;
+}
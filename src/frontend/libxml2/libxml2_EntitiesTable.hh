@@ -24,6 +24,8 @@
 #ifndef __EntitiesTable_hh__
 #define __EntitiesTable_hh__
 
+#include <stddef.h>
+
 typedef struct _EntitiesTableEntry EntitiesTableEntry;
 struct _EntitiesTableEntry {
     const char* name;
@@ -31,6 +33,9 @@ struct _EntitiesTableEntry {
 };
 
 const EntitiesTableEntry* getMathMLEntities(void);
+size_t getMathMLEntityCount(void);
+// returns the entry of the entity with the given name, or NULL
+const EntitiesTableEntry* findMathMLEntity(const char*);
 
 #endif // __EntitiesTable_hh__
 
@@ -29,26 +29,50 @@
 #include "libxml2_Model.hh"
 
 #include <iostream>
+#include <vector>
 #include <libxml/parserInternals.h>
+#include <libxml/entities.h>
 #include <string.h>
 
-static xmlEntity*
-entity_resolver(void* ctxt, const xmlChar *name) {
-  xmlEntity *entity = NULL;
+// The MathML entities referenced by a document are created once per
+// parser, in the internal subset of a scratch document that owns them
+// and is freed when parsing is over
+struct EntityCache
+{
+  EntityCache(void)
+    : doc(xmlNewDoc(BAD_CAST "1.0")), entities(getMathMLEntityCount(), NULL)
+  { xmlCreateIntSubset(doc, BAD_CAST "math", NULL, NULL); }
+  ~EntityCache() { xmlFreeDoc(doc); }
 
-  const EntitiesTableEntry* entities = getMathMLEntities();
+  xmlDoc* doc;
+  std::vector<xmlEntity*> entities;
+};
 
-  for (size_t i = 0; entities[i].name != NULL; i++) {
-    if (strcmp((const char*) name, entities[i].name) == 0) {
-      entity = xmlNewEntity(NULL, name, XML_INTERNAL_GENERAL_ENTITY, NULL, NULL, libxml2_Model::toModelString(entities[i].value));
-      break;
-    }
+static xmlEntity*
+entity_resolver(void* ctxt, const xmlChar *name) {
+  EntityCache* cache = static_cast<EntityCache*>(static_cast<xmlParserCtxt*>(ctxt)->_private);
+
+  if (const EntitiesTableEntry* entry = findMathMLEntity((const char*) name)) {
+    xmlEntity*& entity = cache->entities[entry - getMathMLEntities()];
+    if (entity == NULL)
+      entity = xmlAddDocEntity(cache->doc, name, XML_INTERNAL_GENERAL_ENTITY, NULL, NULL,
+                               libxml2_Model::toModelString(entry->value));
+    return entity;
   }
 
-  if (entity == NULL)
-    entity = xmlGetPredefinedEntity(name);
+  return xmlGetPredefinedEntity(name);
+}
 
-  return entity;
+static xmlDoc*
+parse_with_entities(xmlParserCtxt* ctxt)
+{
+  EntityCache cache;
+  ctxt->_private = &cache;
+  ctxt->sax->getEntity = entity_resolver;
+  xmlParseDocument(ctxt);
+  xmlDoc* doc = ctxt->myDoc;
+  xmlFreeParserCtxt(ctxt);
+  return doc;
 }
 
 xmlDoc*
@@ -63,13 +87,8 @@ libxml2_Model::document(const AbstractLogger& logger, const String& path, bool s
     doc = xmlParseFile(path.c_str());
   } else {
     xmlSubstituteEntitiesDefault(1);
-    xmlParserCtxt *ctxt = xmlCreateFileParserCtxt(path.c_str());
-    if (ctxt != NULL) {
-      ctxt->sax->getEntity = entity_resolver;
-      xmlParseDocument(ctxt);
-      doc = ctxt->myDoc;
-      xmlFreeParserCtxt(ctxt);
-    }
+    if (xmlParserCtxt *ctxt = xmlCreateFileParserCtxt(path.c_str()))
+      doc = parse_with_entities(ctxt);
   }
 
   perf.Stop();
@@ -90,13 +109,8 @@ libxml2_Model::documentFromBuffer(const AbstractLogger& logger, const String& bu
     doc = xmlReadDoc(toModelString(buffer.c_str()), NULL, NULL, 0);
   } else {
     xmlSubstituteEntitiesDefault(1);
-    xmlParserCtxt *ctxt = xmlCreateMemoryParserCtxt(buffer.c_str(), strlen(buffer.c_str()));
-    if (ctxt != NULL) {
-      ctxt->sax->getEntity = entity_resolver;
-      xmlParseDocument(ctxt);
-      doc = ctxt->myDoc;
-      xmlFreeParserCtxt(ctxt);
-    }
+    if (xmlParserCtxt *ctxt = xmlCreateMemoryParserCtxt(buffer.c_str(), strlen(buffer.c_str())))
+      doc = parse_with_entities(ctxt);
   }
 
   perf.Stop();
@@ -27,9 +27,9 @@
 #include "custom_reader_Builder.hh"
 
 custom_reader_MathView::custom_reader_MathView(const SmartPtr<AbstractLogger>& logger)
-  : View(logger), data(0)
+  : View(logger), data(0), builder(custom_reader_Builder::create())
 {
-  setBuilder(custom_reader_Builder::create());
+  setBuilder(builder);
 }
 
 custom_reader_MathView::~custom_reader_MathView()
@@ -47,7 +47,7 @@ bool
 custom_reader_MathView::loadReader(const c_customXmlReader* reader,
 				   c_customModelUserData data)
 {
-  if (SmartPtr<custom_reader_Builder> builder = smart_cast<custom_reader_Builder>(getBuilder()))
+  if (builder)
     {
       resetRootElement();
       builder->setReader(customXmlReader::create(reader, data));
@@ -61,7 +61,7 @@ custom_reader_MathView::loadReader(const c_customXmlReader* reader,
 SmartPtr<Element>
 custom_reader_MathView::elementOfModelElement(c_customModelElementId el) const
 {
-  if (SmartPtr<custom_reader_Builder> builder = smart_cast<custom_reader_Builder>(getBuilder()))
+  if (builder)
     return builder->findElement(el);
   else
     return 0;
@@ -70,7 +70,7 @@ custom_reader_MathView::elementOfModelElement(c_customModelElementId el) const
 c_customModelElementId
 custom_reader_MathView::modelElementOfElement(const SmartPtr<Element>& elem) const
 {
-  if (SmartPtr<custom_reader_Builder> builder = smart_cast<custom_reader_Builder>(getBuilder()))
+  if (builder)
     return builder->findSelfOrAncestorModelElement(elem);
   else
     return 0;
@@ -48,6 +48,10 @@ public:
 
 protected:
   c_customModelUserData data;
+
+private:
+  // the builder set by the constructor, kept with its own type
+  SmartPtr<class custom_reader_Builder> builder;
 };
 
 #endif // __custom_reader_MathView_hh__
@@ -28,9 +28,9 @@
 #include "libxml2_Builder.hh"
 
 libxml2_MathView::libxml2_MathView(const SmartPtr<AbstractLogger>& logger)
-  : View(logger), currentDoc(0), docOwner(false)
+  : View(logger), currentDoc(0), docOwner(false), builder(libxml2_Builder::create())
 {
-  setBuilder(libxml2_Builder::create());
+  setBuilder(builder);
 }
 
 libxml2_MathView::~libxml2_MathView()
@@ -51,7 +51,7 @@ libxml2_MathView::unload()
   if (docOwner && currentDoc) xmlFreeDoc(currentDoc);
   currentDoc = 0;
   docOwner = false;
-  if (SmartPtr<libxml2_Builder> builder = smart_cast<libxml2_Builder>(getBuilder()))
+  if (builder)
     builder->setRootModelElement(0);
 }
 
@@ -115,7 +115,14 @@ libxml2_MathView::loadDocument(xmlDoc* doc)
   if (xmlNode* root = xmlDocGetRootElement(doc))
     {
       const bool res = loadRootElement((xmlElement*) root);
-      if (res) currentDoc = doc;
+      if (res)
+	{
+	  // the view may be reused for many documents, release the
+	  // previous one if it was loaded by the view itself
+	  if (docOwner && currentDoc && currentDoc != doc) xmlFreeDoc(currentDoc);
+	  currentDoc = doc;
+	  docOwner = false;
+	}
       return res;
     }
 
@@ -128,7 +135,7 @@ libxml2_MathView::loadRootElement(xmlElement* elem)
 {
   assert(elem);
 
-  if (SmartPtr<libxml2_Builder> builder = smart_cast<libxml2_Builder>(getBuilder()))
+  if (builder)
     {
       resetRootElement();
       builder->setRootModelElement(elem);
@@ -142,7 +149,7 @@ libxml2_MathView::loadRootElement(xmlElement* elem)
 SmartPtr<Element>
 libxml2_MathView::elementOfModelElement(xmlElement* el) const
 {
-  if (SmartPtr<libxml2_Builder> builder = smart_cast<libxml2_Builder>(getBuilder()))
+  if (builder)
     return builder->findElement(el);
   else
     return 0;  
@@ -151,7 +158,7 @@ libxml2_MathView::elementOfModelElement(xmlElement* el) const
 xmlElement*
 libxml2_MathView::modelElementOfElement(const SmartPtr<Element>& elem) const
 {
-  if (SmartPtr<libxml2_Builder> builder = smart_cast<libxml2_Builder>(getBuilder()))
+  if (builder)
     return (xmlElement*) builder->findSelfOrAncestorModelElement(elem);
   else
     return 0;
@@ -160,7 +167,7 @@ libxml2_MathView::modelElementOfElement(const SmartPtr<Element>& elem) const
 bool
 libxml2_MathView::notifyStructureChanged(xmlElement* el) const
 {
-  if (SmartPtr<libxml2_Builder> builder = smart_cast<libxml2_Builder>(getBuilder()))
+  if (builder)
     return builder->notifyStructureChanged(el);
   else
     return false;
@@ -169,7 +176,7 @@ libxml2_MathView::notifyStructureChanged(xmlElement* el) const
 bool
 libxml2_MathView::notifyAttributeChanged(xmlElement* el, const xmlChar* name) const
 {
-  if (SmartPtr<libxml2_Builder> builder = smart_cast<libxml2_Builder>(getBuilder()))
+  if (builder)
     return builder->notifyAttributeChanged(el, name);
   else
     return false;
@@ -53,6 +53,10 @@ public:
 protected:
   xmlDoc* currentDoc;
   bool docOwner;
+
+private:
+  // the builder set by the constructor, kept with its own type
+  SmartPtr<class libxml2_Builder> builder;
 };
 
 #endif // __libxml2_MathView_hh__
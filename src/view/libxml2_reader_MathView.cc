@@ -28,9 +28,9 @@
 #include "libxml2_reader_Builder.hh"
 
 libxml2_reader_MathView::libxml2_reader_MathView(const SmartPtr<AbstractLogger>& logger)
-  : View(logger)
+  : View(logger), builder(libxml2_reader_Builder::create())
 {
-  setBuilder(libxml2_reader_Builder::create());
+  setBuilder(builder);
 }
 
 libxml2_reader_MathView::~libxml2_reader_MathView()
@@ -47,7 +47,7 @@ libxml2_reader_MathView::unload()
 bool
 libxml2_reader_MathView::loadReader(xmlTextReaderPtr reader)
 {
-  if (SmartPtr<libxml2_reader_Builder> builder = smart_cast<libxml2_reader_Builder>(getBuilder()))
+  if (builder)
     {
       resetRootElement();
       builder->setReader(libxmlXmlReader::create(reader));
@@ -48,6 +48,10 @@ public:
 
 protected:
   xmlDoc* currentDoc;
+
+private:
+  // the builder set by the constructor, kept with its own type
+  SmartPtr<class libxml2_reader_Builder> builder;
 };
 
 #endif // __libxml2_reader_MathView_hh__
@@ -101,7 +101,7 @@ QMathView::QMathView(const QFont& font, const QLoggingCategory& category)
     d->m_rawFont = QRawFont::fromFont(font);
     d->m_backend = Qt_Backend::create(d->m_rawFont);
     d->m_view = MathView::create(new QMathViewLogger(category));
-    d->m_view->setOperatorDictionary(MathMLOperatorDictionary::create());
+    d->m_view->setOperatorDictionary(MathMLOperatorDictionary::getDefault());
     d->m_view->setMathMLNamespaceContext(MathMLNamespaceContext::create(
         d->m_view, d->m_backend->getMathGraphicDevice()
     ));
@@ -114,7 +114,7 @@ QMathView::QMathView(const QFont& font, QLoggingCategory& category)
     d->m_rawFont = QRawFont::fromFont(font);
     d->m_backend = Qt_Backend::create(d->m_rawFont);
     d->m_view = MathView::create(new QMathViewLogger(category));
-    d->m_view->setOperatorDictionary(MathMLOperatorDictionary::create());
+    d->m_view->setOperatorDictionary(MathMLOperatorDictionary::getDefault());
     d->m_view->setMathMLNamespaceContext(MathMLNamespaceContext::create(
         d->m_view, d->m_backend->getMathGraphicDevice()
     ));
@@ -24,6 +24,7 @@
 #include <stdlib.h>
 
 #include <sstream>
+#include <vector>
 
 #include "defs.h"
 
@@ -59,6 +60,7 @@ typedef libxml2_MathView MathView;
 #include "Cairo_Backend.hh"
 #include "Cairo_RenderingContext.hh"
 #include "WrapperArea.hh"
+#include "AreaId.hh"
 #include "GObjectPtr.hh"
 
 #define CLICK_SPACE_RANGE 1
@@ -126,7 +128,6 @@ struct _GtkMathView
   GtkMathViewModelId current_elem;
 
   MathView*      view;
-  Cairo_RenderingContext* renderingContext;
   Cairo_Backend* backend;
 };
 
@@ -276,6 +277,59 @@ gtk_math_view_update(GtkMathView* math_view, gint x0, gint y0, gint width, gint
   cairo_destroy(cr);
 }
 
+static void
+gtk_math_view_setup_rendering_context(GtkMathView* math_view, RenderingContext& rc)
+{
+  GtkStyleContext* context = gtk_widget_get_style_context(GTK_WIDGET(math_view));
+  gtk_style_context_add_class(context, GTK_STYLE_CLASS_VIEW);
+
+  GdkRGBA fore, back;
+  gtk_style_context_get_color(context, GTK_STATE_FLAG_SELECTED, &fore);
+  gtk_style_context_get_background_color(context, GTK_STATE_FLAG_SELECTED, &back);
+  rc.setStyle(RenderingContext::SELECTED_STYLE);
+  rc.setForegroundColor(RGBColorOfGdkRGBA(fore));
+  rc.setBackgroundColor(RGBColorOfGdkRGBA(back));
+
+  gtk_style_context_get_color(context, GTK_STATE_FLAG_NORMAL, &fore);
+  gtk_style_context_get_background_color(context, GTK_STATE_FLAG_NORMAL, &back);
+  rc.setStyle(RenderingContext::NORMAL_STYLE);
+  rc.setForegroundColor(RGBColorOfGdkRGBA(fore));
+  rc.setBackgroundColor(RGBColorOfGdkRGBA(back));
+}
+
+/* repaints the given rectangle (in widget coordinates) of the
+ * backing surface, leaving the rest of the surface untouched */
+static void
+gtk_math_view_paint_rectangle(GtkMathView* math_view, gint x0, gint y0, gint width, gint height)
+{
+  g_return_if_fail(math_view != NULL);
+  g_return_if_fail(math_view->surface != NULL);
+
+  GtkAllocation allocation;
+  gtk_widget_get_allocation(GTK_WIDGET(math_view), &allocation);
+
+  cairo_t *cr = cairo_create(math_view->surface);
+  cairo_rectangle(cr, x0, y0, width, height);
+  cairo_clip(cr);
+  cairo_set_source_rgb(cr, 1, 1, 1);
+  cairo_paint(cr);
+
+  Cairo_RenderingContext rc(cairo_reference(cr));
+  gtk_math_view_setup_rendering_context(math_view, rc);
+
+  // WARNING: setAvailableWidth must be invoked BEFORE any coordinate conversion
+  math_view->view->setAvailableWidth(scaled(allocation.width));
+  gint x = 0;
+  gint y = 0;
+  to_view_coords(math_view, &x, &y);
+  g_signal_emit(math_view, decorate_under_signal, 0, cr);
+  // only the part of the formula that falls inside the rectangle is drawn
+  math_view->view->render(rc, scaled(-x), scaled(y),
+                          Rectangle(scaled(x0), scaled(-(y0 + height)), scaled(width), scaled(height)));
+
+  cairo_destroy(cr);
+}
+
 static void
 gtk_math_view_paint(GtkMathView* math_view)
 {
@@ -288,8 +342,6 @@ gtk_math_view_paint(GtkMathView* math_view)
 
   GtkWidget* widget = GTK_WIDGET(math_view);
   GdkWindow* window = gtk_widget_get_window(widget);
-  GtkStyleContext* context = gtk_widget_get_style_context(widget);
-  gtk_style_context_add_class(context, GTK_STYLE_CLASS_VIEW);
   GtkAllocation allocation;
   gtk_widget_get_allocation(widget, &allocation);
   
@@ -299,42 +351,153 @@ gtk_math_view_paint(GtkMathView* math_view)
   const gint height = allocation.height;
 
   if (math_view->surface == NULL)
-    {
-      math_view->surface = gdk_window_create_similar_surface(window, CAIRO_CONTENT_COLOR, width, height);
-      math_view->renderingContext = new Cairo_RenderingContext(cairo_create(math_view->surface));
-    }
+    math_view->surface = gdk_window_create_similar_surface(window, CAIRO_CONTENT_COLOR, width, height);
 
-  Cairo_RenderingContext* rc = math_view->renderingContext;
-  g_return_if_fail(rc != 0);
+  gtk_math_view_paint_rectangle(math_view, 0, 0, width, height);
+  gtk_math_view_update(math_view, 0, 0, width, height);
+}
 
-  GdkRGBA fore, back;
-  gtk_style_context_get_color(context, GTK_STATE_FLAG_SELECTED, &fore);
-  gtk_style_context_get_background_color(context, GTK_STATE_FLAG_SELECTED, &back);
-  rc->setStyle(RenderingContext::SELECTED_STYLE);
-  rc->setForegroundColor(RGBColorOfGdkRGBA(fore));
-  rc->setBackgroundColor(RGBColorOfGdkRGBA(back));
+/* scrolls the content of the backing surface by (dx, dy) pixels and
+ * renders only the strips that have been exposed by the scrolling */
+static void
+gtk_math_view_scroll(GtkMathView* math_view, gint dx, gint dy)
+{
+  g_return_if_fail(math_view != NULL);
 
-  gtk_style_context_get_color(context, GTK_STATE_FLAG_NORMAL, &fore);
-  gtk_style_context_get_background_color(context, GTK_STATE_FLAG_NORMAL, &back);
-  rc->setStyle(RenderingContext::NORMAL_STYLE);
-  rc->setForegroundColor(RGBColorOfGdkRGBA(fore));
-  rc->setBackgroundColor(RGBColorOfGdkRGBA(back));
+  if (!gtk_widget_get_mapped(GTK_WIDGET(math_view)) || math_view->freeze_counter > 0) return;
+
+  GtkAllocation allocation;
+  gtk_widget_get_allocation(GTK_WIDGET(math_view), &allocation);
+
+  const gint width = allocation.width;
+  const gint height = allocation.height;
 
+  if (math_view->surface == NULL || abs(dx) >= width || abs(dy) >= height)
+    {
+      gtk_math_view_paint(math_view);
+      return;
+    }
+
+  // copying a surface onto itself needs an intermediate group
   cairo_t *cr = cairo_create(math_view->surface);
-  cairo_set_source_rgb(cr, 1, 1, 1);
+  cairo_push_group(cr);
+  cairo_set_source_surface(cr, math_view->surface, -dx, -dy);
+  cairo_paint(cr);
+  cairo_pop_group_to_source(cr);
+  cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
   cairo_paint(cr);
+  cairo_destroy(cr);
 
-  // WARNING: setAvailableWidth must be invoked BEFORE any coordinate conversion
-  math_view->view->setAvailableWidth(scaled(width));
-  gint x = 0;
-  gint y = 0;
-  to_view_coords(math_view, &x, &y);
-  g_signal_emit(math_view, decorate_under_signal, 0, cr);
-  math_view->view->render(*rc, scaled(-x), scaled(y));
+  if (dx > 0)
+    gtk_math_view_paint_rectangle(math_view, width - dx, 0, dx, height);
+  else if (dx < 0)
+    gtk_math_view_paint_rectangle(math_view, 0, 0, -dx, height);
+
+  if (dy > 0)
+    gtk_math_view_paint_rectangle(math_view, 0, height - dy, width, dy);
+  else if (dy < 0)
+    gtk_math_view_paint_rectangle(math_view, 0, 0, width, -dy);
 
   gtk_math_view_update(math_view, 0, 0, width, height);
+}
 
-  cairo_destroy(cr);
+struct ElementExtents
+{
+  SmartPtr<Element> elem;
+  Point origin;
+  BoundingBox box;
+};
+
+/* collects the extents of elem and of all its ancestors, innermost
+ * first, with origins relative to the root element */
+static void
+get_element_path_extents(GtkMathView* math_view, const SmartPtr<Element>& elem,
+                         std::vector<ElementExtents>& path)
+{
+  path.clear();
+
+  // getBoundingBox formats the tree when needed
+  if (!elem || !math_view->view->getBoundingBox().defined()) return;
+
+  SmartPtr<Element> root = math_view->view->getRootElement();
+  AreaRef rootArea = root ? root->getArea() : nullptr;
+  AreaRef elemArea = elem->getArea();
+  if (!rootArea || !elemArea) return;
+
+  AreaId deepId(rootArea);
+  if (!rootArea->searchByArea(deepId, elemArea)) return;
+
+  for (int i = deepId.size(); i >= 0; i--)
+    {
+      AreaRef area = deepId.getArea(i);
+      if (SmartPtr<Element> e = area->getElement())
+        {
+          ElementExtents extents;
+          extents.elem = e;
+          deepId.getOrigin(extents.origin, 0, i);
+          extents.box = area->box();
+          path.push_back(extents);
+        }
+    }
+}
+
+static bool
+same_extents(const ElementExtents& e1, const ElementExtents& e2)
+{
+  return e1.origin.x == e2.origin.x && e1.origin.y == e2.origin.y
+    && e1.box.width == e2.box.width && e1.box.height == e2.box.height && e1.box.depth == e2.box.depth;
+}
+
+/* repaints the part of the widget affected by a change in the element
+ * whose path extents before the change are given: the smallest element
+ * on the path whose extents did not change encloses everything that
+ * moved or was redrawn, anything larger requires a full repaint */
+static void
+gtk_math_view_paint_changed(GtkMathView* math_view, const BoundingBox& oldBox,
+                            const std::vector<ElementExtents>& oldPath)
+{
+  if (!gtk_widget_get_mapped(GTK_WIDGET(math_view)) || math_view->freeze_counter > 0) return;
+
+  const BoundingBox box = math_view->view->getBoundingBox();
+
+  if (math_view->surface == NULL || oldPath.empty() || !box.defined()
+      || box.width != oldBox.width || box.height != oldBox.height || box.depth != oldBox.depth)
+    {
+      gtk_math_view_paint(math_view);
+      return;
+    }
+
+  std::vector<ElementExtents> newPath;
+  for (const auto& old : oldPath)
+    {
+      get_element_path_extents(math_view, old.elem, newPath);
+      if (!newPath.empty()) break;
+    }
+
+  for (const auto& old : oldPath)
+    for (const auto& extents : newPath)
+      if (extents.elem == old.elem)
+        {
+          if (!same_extents(extents, old)) break;
+
+          // the element did not move nor change size, so whatever
+          // changed is inside it, except for the ink overhanging its
+          // box, which is covered by one em of padding
+          gint x0 = 0;
+          gint y0 = 0;
+          to_view_coords(math_view, &x0, &y0);
+          const gint pad = 2 + math_view->view->getDefaultFontSize();
+          const gint x = (gint) floor(extents.origin.x.toDouble()) - x0 - pad;
+          const gint y = (gint) floor(-(extents.origin.y + extents.box.height).toDouble()) - y0 - pad;
+          const gint width = (gint) ceil(extents.box.width.toDouble()) + 2 * pad;
+          const gint height = (gint) ceil(extents.box.verticalExtent().toDouble()) + 2 * pad;
+
+          gtk_math_view_paint_rectangle(math_view, x, y, width, height);
+          gtk_math_view_update(math_view, x, y, width, height);
+          return;
+        }
+
+  gtk_math_view_paint(math_view);
 }
 
 static void
@@ -356,7 +519,7 @@ hadjustment_value_changed(GtkAdjustment* adj, GtkMathView* math_view)
   math_view->top_x = static_cast<int>(value);
 
   if (math_view->old_top_x != math_view->top_x)
-    gtk_math_view_paint(math_view);
+    gtk_math_view_scroll(math_view, math_view->top_x - math_view->old_top_x, 0);
 }
 
 static void
@@ -378,7 +541,7 @@ vadjustment_value_changed(GtkAdjustment* adj, GtkMathView* math_view)
   math_view->top_y = static_cast<int>(value);
 
   if (math_view->old_top_y != math_view->top_y)
-    gtk_math_view_paint(math_view);
+    gtk_math_view_scroll(math_view, 0, math_view->top_y - math_view->old_top_y);
 }
 
 extern "C" GType
@@ -417,7 +580,7 @@ gtk_math_view_base_class_init(GtkMathViewClass* math_view_class)
   logger->ref();
   math_view_class->logger = logger;
 
-  SmartPtr<MathMLOperatorDictionary> dictionary = MathMLOperatorDictionary::create();
+  SmartPtr<MathMLOperatorDictionary> dictionary = MathMLOperatorDictionary::getDefault();
   dictionary->ref();
   math_view_class->dictionary = dictionary;
 }
@@ -556,7 +719,6 @@ gtk_math_view_init(GtkMathView* math_view)
 
   math_view->surface         = NULL;
   math_view->view            = 0;
-  math_view->renderingContext = 0;
   math_view->backend         = 0;
   math_view->freeze_counter  = 0;
   math_view->select_state    = SELECT_STATE_NO;
@@ -589,6 +751,8 @@ gtk_math_view_init(GtkMathView* math_view)
   view->setDefaultFontSize(DEFAULT_FONT_SIZE);
   view->setOperatorDictionary(math_view_class->dictionary);
   view->setMathMLNamespaceContext(MathMLNamespaceContext::create(view, backend->getMathGraphicDevice()));
+  // hit testing runs on every pointer motion
+  view->setUseSpatialIndex(true);
 }
 
 extern "C" GtkWidget*
@@ -618,12 +782,6 @@ gtk_math_view_destroy(GtkWidget* widget)
       math_view->view = 0;
     }
 
-  if (math_view->renderingContext)
-    {
-      delete math_view->renderingContext;
-      math_view->renderingContext = 0;
-    }
-
   if (math_view->backend)
     {
       math_view->backend->unref();
@@ -1269,9 +1427,12 @@ GTKMATHVIEW_METHOD_NAME(structure_changed)(GtkMathView* math_view, GtkMathViewMo
 {
   g_return_val_if_fail(math_view != NULL, FALSE);
   g_return_val_if_fail(math_view->view != NULL, FALSE);
+  const BoundingBox oldBox = math_view->view->getBoundingBox();
+  std::vector<ElementExtents> oldPath;
+  get_element_path_extents(math_view, math_view->view->elementOfModelElement(elem), oldPath);
   if (math_view->view->notifyStructureChanged(elem))
     {
-      gtk_math_view_paint(math_view);
+      gtk_math_view_paint_changed(math_view, oldBox, oldPath);
       return TRUE;
     }
   else
@@ -1283,9 +1444,12 @@ GTKMATHVIEW_METHOD_NAME(attribute_changed)(GtkMathView* math_view, GtkMathViewMo
 {
   g_return_val_if_fail(math_view != NULL, FALSE);
   g_return_val_if_fail(math_view->view != NULL, FALSE);
+  const BoundingBox oldBox = math_view->view->getBoundingBox();
+  std::vector<ElementExtents> oldPath;
+  get_element_path_extents(math_view, math_view->view->elementOfModelElement(elem), oldPath);
   if (math_view->view->notifyAttributeChanged(elem, name))
     {
-      gtk_math_view_paint(math_view);
+      gtk_math_view_paint_changed(math_view, oldBox, oldPath);
       return TRUE;
     }
   else
@@ -1586,7 +1750,6 @@ GTKMATHVIEW_METHOD_NAME(set_log_verbosity)(GtkMathView* math_view, gint level)
 {
   g_return_if_fail(math_view != NULL);
   g_return_if_fail(math_view->view != 0);
-  g_return_if_fail(math_view->renderingContext != 0);
   math_view->view->getLogger()->setLogLevel(LogLevelId(level));
 }
 
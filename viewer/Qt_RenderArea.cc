@@ -33,7 +33,7 @@ Qt_RenderArea::Qt_RenderArea(SmartPtr<AbstractLogger> logger,
     m_rawFont = QRawFont::fromFont(QFont(DEFAULT_FONT_FAMILY, DEFAULT_FONT_SIZE));
     m_backend = Qt_Backend::create(m_rawFont);
     m_device = m_backend->getMathGraphicDevice();
-    m_dictionary = MathMLOperatorDictionary::create();
+    m_dictionary = MathMLOperatorDictionary::getDefault();
     m_view = MathView::create(logger);
     m_view->setOperatorDictionary(m_dictionary);
     m_view->setMathMLNamespaceContext(MathMLNamespaceContext::create(m_view, m_device));
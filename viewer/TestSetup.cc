@@ -0,0 +1,72 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#include <config.h>
+
+#include <cairo-ft.h>
+
+#include "defs.h"
+#include "Logger.hh"
+#include "MathMLOperatorDictionary.hh"
+#include "MathMLNamespaceContext.hh"
+#include "MathGraphicDevice.hh"
+#include "TestSetup.hh"
+
+TestSetup::TestSetup()
+  : fontFace(nullptr), font(nullptr)
+{
+  FcResult result;
+  FcPattern* pattern = FcPatternCreate();
+  FcPatternAddString(pattern, FC_FAMILY, (FcChar8 *) DEFAULT_FONT_FAMILY);
+  FcConfigSubstitute(NULL, pattern, FcMatchPattern);
+  FcDefaultSubstitute(pattern);
+  FcPattern* resolved = FcFontMatch(NULL, pattern, &result);
+  FcPatternDestroy(pattern);
+  if (!resolved) return;
+
+  // the font face holds a reference to the pattern
+  fontFace = cairo_ft_font_face_create_for_pattern(resolved);
+  FcPatternDestroy(resolved);
+
+  cairo_matrix_t font_matrix, font_ctm;
+  cairo_matrix_init_scale(&font_matrix, DEFAULT_FONT_SIZE, DEFAULT_FONT_SIZE);
+  cairo_matrix_init_identity(&font_ctm);
+  cairo_font_options_t* font_options = cairo_font_options_create();
+  font = cairo_scaled_font_create(fontFace, &font_matrix, &font_ctm, font_options);
+  cairo_font_options_destroy(font_options);
+
+  SmartPtr<AbstractLogger> logger = Logger::create();
+  logger->setLogLevel(LOG_WARNING);
+
+  backend = Cairo_Backend::create(font);
+  view = libxml2_MathView::create(logger);
+  view->setOperatorDictionary(MathMLOperatorDictionary::getDefault());
+  view->setMathMLNamespaceContext(MathMLNamespaceContext::create(view, backend->getMathGraphicDevice()));
+}
+
+TestSetup::~TestSetup()
+{
+  if (view) view->resetRootElement();
+  // the view and the backend may hold areas referencing the font
+  view = nullptr;
+  backend = nullptr;
+  if (font) cairo_scaled_font_destroy(font);
+  if (fontFace) cairo_font_face_destroy(fontFace);
+}
@@ -0,0 +1,63 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef __TestSetup_hh__
+#define __TestSetup_hh__
+
+#include <stdio.h>
+
+#include <cairo.h>
+
+#include "SmartPtr.hh"
+#include "libxml2_MathView.hh"
+#include "Cairo_Backend.hh"
+
+// TestSetup opens the default font at the default size and builds a
+// Cairo backend and a libxml2 view on it, as needed by the test
+// programs. The destructor releases everything the constructor
+// allocates
+
+class TestSetup
+{
+public:
+  TestSetup(void);
+  ~TestSetup();
+
+  TestSetup(const TestSetup&) = delete;
+  TestSetup& operator=(const TestSetup&) = delete;
+
+  bool ready(void) const { return font != nullptr; }
+  cairo_scaled_font_t* getFont(void) const { return font; }
+  const SmartPtr<Cairo_Backend>& getBackend(void) const { return backend; }
+  const SmartPtr<libxml2_MathView>& getView(void) const { return view; }
+
+private:
+  cairo_font_face_t* fontFace;
+  cairo_scaled_font_t* font;
+  SmartPtr<Cairo_Backend> backend;
+  SmartPtr<libxml2_MathView> view;
+};
+
+// prints the message when the condition does not hold and counts the
+// failures, which the test programs return as their exit status
+#define TEST_CHECK(failures, cond, ...) \
+  do { if (!(cond)) { printf(__VA_ARGS__); printf("\n"); (failures)++; } } while (0)
+
+#endif // __TestSetup_hh__
@@ -25,6 +25,8 @@
 
 #include <cairo.h>
 #include <cairo-ft.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
 #ifdef CAIRO_HAS_SVG_SURFACE
 #  include <cairo-svg.h>
 #endif
@@ -38,12 +40,17 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 
 #include "defs.h"
 #include "Logger.hh"
 #include "libxml2_MathView.hh"
+#include "Element.hh"
 #include "MathMLOperatorDictionary.hh"
 #include "Cairo_Backend.hh"
 #include "Cairo_RenderingContext.hh"
@@ -62,9 +69,15 @@ typedef libxml2_MathView MathView;
 static char **remaining_args = NULL;
 static char *fontname = (char*) DEFAULT_FONT_FAMILY;
 static int fontsize = DEFAULT_FONT_SIZE;
+static char *batchfile = NULL;
+static char *summaryfile = NULL;
+static int jobs = 1;
 static GOptionEntry entries[] = {
   { "font-family", 'f', 0, G_OPTION_ARG_STRING, &fontname, "Font name (default: " DEF_FONT_FAMILY ")",     "family" },
   { "face-size",   's', 0, G_OPTION_ARG_INT,    &fontsize, "Face size (default: " DEF_FONT_SIZE ")", "size" },
+  { "batch",       'b', 0, G_OPTION_ARG_FILENAME, &batchfile, "Render the INPUT OUTPUT pairs listed one per line in the manifest (- for stdin)", "manifest" },
+  { "summary",     'S', 0, G_OPTION_ARG_FILENAME, &summaryfile, "Write the per-document timings of the batch to this file (default: stdout)", "file" },
+  { "jobs",        'j', 0, G_OPTION_ARG_INT,    &jobs, "Number of threads rendering the batch (default: 1)", "n" },
   { G_OPTION_REMAINING, '\0', 0, G_OPTION_ARG_FILENAME_ARRAY, &remaining_args, NULL, "[FILE...]" },
   { NULL, 0, 0, G_OPTION_ARG_NONE, NULL, NULL, NULL }
 };
@@ -104,6 +117,217 @@ create_surface(const String filename, double width, double height)
   return surface;
 }
 
+struct RenderTimes
+{
+  gint64 load;
+  gint64 build;
+  gint64 format;
+  gint64 render;
+};
+
+static bool
+render_file(const SmartPtr<MathView>& view, const String& input_file, const String& output_file, RenderTimes& times)
+{
+  times.load = times.build = times.format = times.render = 0;
+
+  gint64 start = g_get_monotonic_time();
+  const bool loaded = view->loadURI(input_file);
+  times.load = g_get_monotonic_time() - start;
+  if (!loaded) return false;
+
+  // building and formatting are lazy, force them here to time them apart
+  start = g_get_monotonic_time();
+  view->getRootElement();
+  times.build = g_get_monotonic_time() - start;
+
+  start = g_get_monotonic_time();
+  const BoundingBox box = view->getBoundingBox();
+  times.format = g_get_monotonic_time() - start;
+
+  double width = box.horizontalExtent().toDouble();
+  double height = box.verticalExtent().toDouble();
+  cairo_surface_t* surface = create_surface(output_file, width, height);
+  if (!surface) return false;
+
+  start = g_get_monotonic_time();
+  cairo_t* cr = cairo_create(surface);
+  {
+    Cairo_RenderingContext rc(cairo_reference(cr));
+    view->render(rc, scaled::zero(), -box.height);
+  }
+
+  if (cairo_surface_get_type(surface) == CAIRO_SURFACE_TYPE_IMAGE)
+    cairo_surface_write_to_png(surface, output_file.c_str());
+
+  cairo_destroy(cr);
+  cairo_surface_destroy(surface);
+  times.render = g_get_monotonic_time() - start;
+
+  return true;
+}
+
+struct BatchItem
+{
+  String input;
+  String output;
+  bool valid;
+  bool ok;
+  RenderTimes times;
+};
+
+static void
+read_manifest(FILE* manifest, std::vector<BatchItem>& items)
+{
+  char line[4096];
+  while (fgets(line, sizeof(line), manifest))
+  {
+    gchar** fields = g_strsplit_set(g_strstrip(line), " \t", -1);
+    std::vector<String> args;
+    for (gchar** p = fields; *p; p++)
+      if (**p) args.push_back(*p);
+    g_strfreev(fields);
+
+    // blank lines and comments
+    if (args.empty() || args[0][0] == '#') continue;
+
+    BatchItem item;
+    item.valid = args.size() == 2;
+    if (!item.valid) g_print("malformed manifest line: %s\n", line);
+    args.resize(2);
+    item.input = args[0];
+    item.output = args[1];
+    item.ok = false;
+    item.times.load = item.times.build = item.times.format = item.times.render = 0;
+    items.push_back(item);
+  }
+}
+
+static void
+destroy_face(void* face)
+{
+  FT_Done_Face(static_cast<FT_Face>(face));
+}
+
+/* creates a scaled font with a FreeType face of its own: faces cannot
+ * be used by more than one thread at a time, and cairo shares the face
+ * among all the fonts created from the same file */
+static cairo_scaled_font_t*
+create_private_font(FcPattern* resolved, FT_Library library)
+{
+  static cairo_user_data_key_t face_key;
+
+  FcChar8* file;
+  int index = 0;
+  if (FcPatternGetString(resolved, FC_FILE, 0, &file) != FcResultMatch) return NULL;
+  FcPatternGetInteger(resolved, FC_INDEX, 0, &index);
+
+  FT_Face face;
+  if (FT_New_Face(library, (const char*) file, index, &face)) return NULL;
+
+  cairo_font_face_t* font_face = cairo_ft_font_face_create_for_ft_face(face, 0);
+  cairo_font_face_set_user_data(font_face, &face_key, face, destroy_face);
+
+  cairo_matrix_t font_matrix, font_ctm;
+  cairo_matrix_init_scale(&font_matrix, fontsize, fontsize);
+  cairo_matrix_init_identity(&font_ctm);
+  cairo_font_options_t* font_options = cairo_font_options_create();
+  cairo_scaled_font_t* font = cairo_scaled_font_create(font_face, &font_matrix, &font_ctm, font_options);
+  cairo_font_options_destroy(font_options);
+  cairo_font_face_destroy(font_face);
+
+  return font;
+}
+
+/* renders the batch items not yet taken by other workers. Each worker
+ * owns its font, backend and view, only the operator dictionary is
+ * shared */
+static void
+render_items(cairo_scaled_font_t* font, const SmartPtr<MathMLOperatorDictionary>& dictionary,
+	     std::vector<BatchItem>& items, std::atomic<unsigned>& next)
+{
+  SmartPtr<AbstractLogger> logger = Logger::create();
+  logger->setLogLevel(LOG_WARNING);
+
+  SmartPtr<Backend> backend = Cairo_Backend::create(font);
+  SmartPtr<MathView> view = MathView::create(logger);
+  view->setOperatorDictionary(dictionary);
+  view->setMathMLNamespaceContext(MathMLNamespaceContext::create(view, backend->getMathGraphicDevice()));
+  view->setDefaultFontSize(fontsize);
+
+  for (unsigned i = next++; i < items.size(); i = next++)
+    if (items[i].valid)
+      items[i].ok = render_file(view, items[i].input, items[i].output, items[i].times);
+
+  view->unload();
+}
+
+/* renders every INPUT OUTPUT pair of the manifest using the given
+ * number of worker threads, then writes one tab-separated line of
+ * timings (in microseconds) per document to the summary */
+static int
+render_batch(FcPattern* resolved, int jobs, FILE* manifest, FILE* summary)
+{
+  std::vector<BatchItem> items;
+  read_manifest(manifest, items);
+
+  const unsigned workers = std::max(1, std::min(jobs, static_cast<int>(items.size())));
+
+  // the library is never released because cairo may keep some
+  // font faces in its caches until the program terminates
+  FT_Library library;
+  if (FT_Init_FreeType(&library))
+  {
+    g_print("can't initialize FreeType\n");
+    return items.size();
+  }
+
+  // FreeType requires faces of the same library to be created by one
+  // thread at a time
+  std::vector<cairo_scaled_font_t*> fonts;
+  for (unsigned i = 0; i < workers; i++)
+    if (cairo_scaled_font_t* font = create_private_font(resolved, library))
+      fonts.push_back(font);
+    else
+    {
+      g_print("can't load font\n");
+      return items.size();
+    }
+
+  SmartPtr<MathMLOperatorDictionary> dictionary = MathMLOperatorDictionary::getDefault();
+
+  xmlInitParser();
+  const gint64 start = g_get_monotonic_time();
+  std::atomic<unsigned> next(0);
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < workers; i++)
+    threads.push_back(std::thread(render_items, fonts[i], std::cref(dictionary), std::ref(items), std::ref(next)));
+  render_items(fonts[0], dictionary, items, next);
+  for (auto& t : threads)
+    t.join();
+  const gint64 elapsed = g_get_monotonic_time() - start;
+
+  // the wall clock time of the whole batch, to compare runs with a
+  // different number of jobs (see scripts/batchScaling)
+  g_printerr("%u documents, %u threads: %" G_GINT64_FORMAT "us, %.1f documents/s\n",
+	     unsigned(items.size()), workers, elapsed,
+	     elapsed > 0 ? 1e6 * items.size() / elapsed : 0.0);
+
+  for (auto font : fonts)
+    cairo_scaled_font_destroy(font);
+
+  fprintf(summary, "input\toutput\tstatus\tload_us\tbuild_us\tformat_us\trender_us\n");
+  int failures = 0;
+  for (const auto& item : items)
+  {
+    if (!item.ok) failures++;
+    fprintf(summary, "%s\t%s\t%s\t%" G_GINT64_FORMAT "\t%" G_GINT64_FORMAT "\t%" G_GINT64_FORMAT "\t%" G_GINT64_FORMAT "\n",
+	    item.input.c_str(), item.output.c_str(), item.ok ? "ok" : "error",
+	    item.times.load, item.times.build, item.times.format, item.times.render);
+  }
+
+  return failures;
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -117,23 +341,44 @@ main(int argc, char *argv[])
     exit(1);
   }
 
-  if (remaining_args == NULL || remaining_args[1] == NULL)
+  if (batchfile == NULL && (remaining_args == NULL || remaining_args[1] == NULL))
   {
     g_print("no input or output files specified\n");
     exit(1);
   }
 
-  const String input_file = remaining_args[0];
-  const String output_file = remaining_args[1];
-
-  SmartPtr<AbstractLogger> logger = Logger::create();
-
   FcResult result;
   FcPattern* pattern = FcPatternCreate();
   FcPatternAddString(pattern, FC_FAMILY, (FcChar8 *) fontname);
   FcConfigSubstitute(NULL, pattern, FcMatchPattern);
   FcDefaultSubstitute(pattern);
   FcPattern* resolved = FcFontMatch(NULL, pattern, &result);
+
+  if (batchfile != NULL)
+  {
+    FILE* manifest = strcmp(batchfile, "-") ? fopen(batchfile, "r") : stdin;
+    if (manifest == NULL)
+    {
+      g_print("can't open manifest %s\n", batchfile);
+      exit(1);
+    }
+
+    FILE* summary = stdout;
+    if (summaryfile != NULL && (summary = fopen(summaryfile, "w")) == NULL)
+    {
+      g_print("can't open summary %s\n", summaryfile);
+      exit(1);
+    }
+
+    const int failures = render_batch(resolved, jobs, manifest, summary);
+    if (manifest != stdin) fclose(manifest);
+    if (summary != stdout) fclose(summary);
+
+    return failures ? 1 : 0;
+  }
+
+  SmartPtr<AbstractLogger> logger = Logger::create();
+
   cairo_font_face_t* font_face = cairo_ft_font_face_create_for_pattern(resolved);
 
   cairo_matrix_t font_matrix, font_ctm;
@@ -145,37 +390,19 @@ main(int argc, char *argv[])
 
   SmartPtr<Backend> backend = Cairo_Backend::create(font);
   SmartPtr<MathGraphicDevice> device = backend->getMathGraphicDevice();
-  SmartPtr<MathMLOperatorDictionary> dictionary = MathMLOperatorDictionary::create();
+  SmartPtr<MathMLOperatorDictionary> dictionary = MathMLOperatorDictionary::getDefault();
 
   SmartPtr<MathView> view = MathView::create(logger);
   view->setOperatorDictionary(dictionary);
   view->setMathMLNamespaceContext(MathMLNamespaceContext::create(view, device));
   view->setDefaultFontSize(fontsize);
 
-  view->loadURI(input_file);
-
-  const BoundingBox box = view->getBoundingBox();
-  double width = box.horizontalExtent().toDouble();
-  double height = box.verticalExtent().toDouble();
-  cairo_surface_t* surface = create_surface(output_file, width, height);
-  if (surface)
-  {
-    cairo_t* cr = cairo_create(surface);
-    Cairo_RenderingContext* rc = new Cairo_RenderingContext(cr);
-
-    view->render(*rc, scaled::zero(), -box.height);
-
-    if (cairo_surface_get_type(surface) == CAIRO_SURFACE_TYPE_IMAGE)
-      cairo_surface_write_to_png(surface, output_file.c_str());
-
-    cairo_destroy(cr);
-    cairo_surface_destroy(surface);
-  }
-
+  RenderTimes times;
+  const int status = render_file(view, remaining_args[0], remaining_args[1], times) ? 0 : 1;
   view->resetRootElement();
 
   cairo_scaled_font_destroy(font);
   cairo_font_face_destroy(font_face);
 
-  return 0;
+  return status;
 }
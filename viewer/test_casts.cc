@@ -0,0 +1,212 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+/* Check the kind tags of the elements and the areas of a formatted
+ * document against dynamic_cast, node by node and for every class
+ * declaring a kind, then measure the cost of the type tests done while
+ * formatting and rendering. The nodes are tested for a few classes,
+ * first comparing the kind stored in every node and area, then with
+ * dynamic_cast, which is what is_a and smart_cast used to do.
+ * Formatting and rendering times are printed as well, to be compared
+ * with those of a build without kind tags.
+ * Usage: test_casts FILE [ITERATIONS] */
+
+#include <config.h>
+
+#include <cairo.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "Clock.hh"
+#include "Cairo_RenderingContext.hh"
+#include "MathMLBinContainerElement.hh"
+#include "MathMLFractionElement.hh"
+#include "MathMLInferredRowElement.hh"
+#include "MathMLNormalizingContainerElement.hh"
+#include "MathMLOperatorElement.hh"
+#include "MathMLRowElement.hh"
+#include "MathMLScriptElement.hh"
+#include "MathMLStyleElement.hh"
+#include "MathMLTableElement.hh"
+#include "GlyphArea.hh"
+#include "GlyphStringArea.hh"
+#include "HorizontalArrayArea.hh"
+#include "OverlapArrayArea.hh"
+#include "VerticalArrayArea.hh"
+#include "WrapperArea.hh"
+#include "TestSetup.hh"
+
+typedef libxml2_MathView MathView;
+
+static void
+collect(const AreaRef& area, std::vector<const Area*>& areas, std::vector<const Element*>& elements)
+{
+  areas.push_back(area);
+  if (SmartPtr<Element> elem = area->getElement())
+    if (elements.empty() || elements.back() != elem) elements.push_back(elem);
+  for (AreaIndex i = 0; i < area->size(); i++)
+    collect(area->node(i), areas, elements);
+}
+
+// kind_isa and kind_cast must agree with dynamic_cast on p
+template <class Q, class R>
+static int
+check_kind(const char* what, unsigned index, const char* name, const R* p)
+{
+  int failures = 0;
+  const Q* dynamic = dynamic_cast<const Q*>(p);
+  TEST_CHECK(failures, kind_isa<Q>(p) == (dynamic != nullptr) && kind_cast<const Q>(p) == dynamic,
+	     "%s %u: kind and dynamic_cast disagree on %s", what, index, name);
+  return failures;
+}
+
+#define CHECK_KIND(what, i, Class, p) check_kind<Class>(what, i, #Class, p)
+
+static int
+check_kinds(const std::vector<const Element*>& elements, const std::vector<const Area*>& areas)
+{
+  int failures = 0;
+  for (unsigned i = 0; i < elements.size(); i++)
+    {
+      const Element* elem = elements[i];
+      failures += CHECK_KIND("element", i, MathMLElement, elem);
+      failures += CHECK_KIND("element", i, MathMLTokenElement, elem);
+      failures += CHECK_KIND("element", i, MathMLOperatorElement, elem);
+      failures += CHECK_KIND("element", i, MathMLContainerElement, elem);
+      failures += CHECK_KIND("element", i, MathMLLinearContainerElement, elem);
+      failures += CHECK_KIND("element", i, MathMLRowElement, elem);
+      failures += CHECK_KIND("element", i, MathMLInferredRowElement, elem);
+      failures += CHECK_KIND("element", i, MathMLBinContainerElement, elem);
+      failures += CHECK_KIND("element", i, MathMLNormalizingContainerElement, elem);
+      failures += CHECK_KIND("element", i, MathMLStyleElement, elem);
+      failures += CHECK_KIND("element", i, MathMLFractionElement, elem);
+      failures += CHECK_KIND("element", i, MathMLScriptElement, elem);
+      failures += CHECK_KIND("element", i, MathMLTableElement, elem);
+    }
+
+  for (unsigned i = 0; i < areas.size(); i++)
+    {
+      const Area* area = areas[i];
+      failures += CHECK_KIND("area", i, HorizontalArrayArea, area);
+      failures += CHECK_KIND("area", i, GlyphStringArea, area);
+      failures += CHECK_KIND("area", i, VerticalArrayArea, area);
+      failures += CHECK_KIND("area", i, OverlapArrayArea, area);
+      failures += CHECK_KIND("area", i, GlyphArea, area);
+      failures += CHECK_KIND("area", i, WrapperArea, area);
+    }
+
+  return failures;
+}
+
+int
+main(int argc, char *argv[])
+{
+  if (argc < 2)
+    {
+      printf("usage: %s FILE [ITERATIONS]\n", argv[0]);
+      exit(1);
+    }
+
+  const int iterations = (argc > 2) ? atoi(argv[2]) : 100;
+
+  TestSetup setup;
+  if (!setup.ready())
+    {
+      printf("could not open the default font\n");
+      exit(1);
+    }
+
+  const SmartPtr<MathView>& view = setup.getView();
+  if (!view->loadURI(argv[1]))
+    {
+      printf("could not load %s\n", argv[1]);
+      exit(1);
+    }
+
+  const BoundingBox box = view->getBoundingBox();
+  std::vector<const Area*> areas;
+  std::vector<const Element*> elements;
+  collect(view->getRootElement()->getArea(), areas, elements);
+  const int failures = check_kinds(elements, areas);
+
+  Clock perf;
+  unsigned kindCount = 0;
+  perf.Start();
+  for (int i = 0; i < iterations; i++)
+    {
+      for (const auto & elem : elements)
+	kindCount += kind_isa<MathMLTokenElement>(elem) + kind_isa<MathMLRowElement>(elem)
+	  + kind_isa<MathMLOperatorElement>(elem);
+      for (const auto & area : areas)
+	kindCount += kind_isa<HorizontalArrayArea>(area) + kind_isa<GlyphArea>(area);
+    }
+  perf.Stop();
+  const long kindTime = perf();
+
+  unsigned dynamicCount = 0;
+  perf.Start();
+  for (int i = 0; i < iterations; i++)
+    {
+      for (const auto & elem : elements)
+	dynamicCount += (dynamic_cast<const MathMLTokenElement*>(elem) != nullptr)
+	  + (dynamic_cast<const MathMLRowElement*>(elem) != nullptr)
+	  + (dynamic_cast<const MathMLOperatorElement*>(elem) != nullptr);
+      for (const auto & area : areas)
+	dynamicCount += (dynamic_cast<const HorizontalArrayArea*>(area) != nullptr)
+	  + (dynamic_cast<const GlyphArea*>(area) != nullptr);
+    }
+  perf.Stop();
+  const long dynamicTime = perf();
+
+  perf.Start();
+  for (int i = 0; i < iterations; i++)
+    {
+      view->setDirtyLayout();
+      view->getBoundingBox();
+    }
+  perf.Stop();
+  const long formatTime = perf();
+
+  const int width = box.width.toInt() + 1;
+  const int height = box.verticalExtent().toInt() + 1;
+  cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+  perf.Start();
+  for (int i = 0; i < iterations; i++)
+    {
+      Cairo_RenderingContext rc(cairo_create(surface));
+      view->render(rc, scaled::zero(), -box.height);
+    }
+  perf.Stop();
+  const long renderTime = perf();
+  cairo_surface_destroy(surface);
+
+  printf("%d iterations, %u elements, %u areas\n",
+	 iterations, unsigned(elements.size()), unsigned(areas.size()));
+  // the counts keep the type tests from being optimized away
+  printf("type tests:   %ldms with kinds, %ldms with dynamic_cast (%u and %u hits)\n",
+	 kindTime, dynamicTime, kindCount, dynamicCount);
+  printf("formatting:   %ldms (%.3fms each)\n", formatTime, double(formatTime) / iterations);
+  printf("rendering:    %ldms (%.3fms each)\n", renderTime, double(renderTime) / iterations);
+  printf("failures:     %d\n", failures);
+
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,395 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+/* Measure the time taken to build and to format the element tree of
+ * a document, repeating each phase a number of times. Reference
+ * counting is on the hot path of both phases, so comparing a build
+ * configured with --disable-atomic-refcount with the default one gives
+ * the cost of atomic reference counting. Formatting is measured with
+ * areas allocated on the heap and in an AreaArena, and every element
+ * must get the same box in both cases. The boxes, edges and origins
+ * cached by the containers are checked against those computed from
+ * their children. Deeply nested documents, such
+ * as tests/frac2.xml, stress the layout schemata that query the boxes
+ * and edges of the formatted children. The attribute values of the
+ * document must be parsed only once, rebuilding the element tree
+ * finds them all interned. Changing an attribute of a leaf of a large
+ * document must only lay out the leaf and its ancestors again. Finally
+ * no arena may outlive the areas of its pass, even when radicals and
+ * fractions stretch their symbols.
+ * Usage: test_formatting FILE [ITERATIONS] */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Clock.hh"
+#include "Attribute.hh"
+#include "Element.hh"
+#include "MathMLAttributeSignatures.hh"
+#include "MathMLmathElement.hh"
+#include "MathMLRowElement.hh"
+#include "MathMLScriptElement.hh"
+#include "HorizontalArrayArea.hh"
+#include "VerticalArrayArea.hh"
+#include "AreaArena.hh"
+#include "MathFontRegistry.hh"
+#include "AttributeSignature.hh"
+#include "TestSetup.hh"
+
+typedef libxml2_MathView MathView;
+
+struct ElementBox
+{
+  const Element* elem;
+  BoundingBox box;
+};
+
+static void
+collect(const AreaRef& area, std::vector<ElementBox>& boxes)
+{
+  if (SmartPtr<Element> elem = area->getElement())
+    if (boxes.empty() || boxes.back().elem != elem)
+      {
+	ElementBox eb;
+	eb.elem = elem;
+	eb.box = area->box();
+	boxes.push_back(eb);
+      }
+  for (AreaIndex i = 0; i < area->size(); i++)
+    collect(area->node(i), boxes);
+}
+
+static std::vector<ElementBox>
+element_boxes(const SmartPtr<MathView>& view)
+{
+  std::vector<ElementBox> boxes;
+  if (SmartPtr<Element> root = view->getRootElement())
+    if (AreaRef area = root->getArea())
+      collect(area, boxes);
+  return boxes;
+}
+
+static bool
+same_box(const BoundingBox& box1, const BoundingBox& box2)
+{
+  return box1.width == box2.width && box1.height == box2.height && box1.depth == box2.depth;
+}
+
+// the values cached by the containers when they are created must be
+// those computed from their children on demand, as they used to be
+static bool
+same_point(const Point& p1, const Point& p2)
+{ return p1.x == p2.x && p1.y == p2.y; }
+
+static int
+check_horizontal(const SmartPtr<const HorizontalArrayArea>& area)
+{
+  int failures = 0;
+  BoundingBox box;
+  scaled step = 0;
+  scaled left = scaled::max();
+  scaled right = scaled::min();
+  Point origin;
+  CharIndex length = 0;
+  for (AreaIndex i = 0; i < area->size(); i++)
+    {
+      const AreaRef child = area->node(i);
+      Point o;
+      area->origin(i, o);
+      TEST_CHECK(failures, same_point(o, origin), "horizontal array: wrong origin of child %d", i);
+      TEST_CHECK(failures, area->lengthTo(i) == length, "horizontal array: wrong length to child %d", i);
+
+      const BoundingBox childBox = child->box();
+      if (child->leftEdge() < scaled::max()) left = std::min(left, origin.x + child->leftEdge());
+      if (child->rightEdge() > scaled::min()) right = std::max(right, origin.x + child->rightEdge());
+      box.append(childBox);
+      box.height -= child->getStep();
+      box.depth += child->getStep();
+      step += child->getStep();
+      origin.x += childBox.horizontalExtent();
+      origin.y += child->getStep();
+      length += child->length();
+    }
+  box.height += step;
+  box.depth -= step;
+
+  TEST_CHECK(failures, same_box(area->box(), box), "horizontal array: wrong box");
+  TEST_CHECK(failures, area->getStep() == step, "horizontal array: wrong step");
+  TEST_CHECK(failures, area->leftEdge() == left, "horizontal array: wrong left edge");
+  TEST_CHECK(failures, area->rightEdge() == right, "horizontal array: wrong right edge");
+  return failures;
+}
+
+static int
+check_vertical(const SmartPtr<const VerticalArrayArea>& area)
+{
+  int failures = 0;
+  const AreaIndex ref = area->getRefArea();
+  const BoundingBox refBox = area->node(ref)->box();
+  BoundingBox box = refBox;
+  for (AreaIndex i = 0; i < area->size(); i++)
+    if (i < ref)
+      box.over(area->node(i)->box());
+    else if (i > ref)
+      box.under(area->node(i)->box());
+  TEST_CHECK(failures, same_box(area->box(), box), "vertical array: wrong box");
+
+  for (AreaIndex i = 0; i < area->size(); i++)
+    {
+      Point origin;
+      if (i < ref)
+	{
+	  if (BoundingBox b = area->node(i)->box()) origin.y -= b.height;
+	  if (refBox) origin.y -= refBox.depth;
+	  for (AreaIndex j = i + 1; j < ref; j++)
+	    if (BoundingBox b = area->node(j)->box()) origin.y -= b.verticalExtent();
+	}
+      else if (i > ref)
+	{
+	  if (refBox) origin.y += refBox.height;
+	  if (BoundingBox b = area->node(i)->box()) origin.y += b.depth;
+	  for (AreaIndex j = ref + 1; j < i; j++)
+	    if (BoundingBox b = area->node(j)->box()) origin.y += b.verticalExtent();
+	}
+      Point o;
+      area->origin(i, o);
+      TEST_CHECK(failures, same_point(o, origin), "vertical array: wrong origin of child %d", i);
+
+      // characters are counted from the last child
+      CharIndex length = 0;
+      for (AreaIndex j = area->size() - i; j < area->size(); j++)
+	length += area->node(j)->length();
+      TEST_CHECK(failures, area->lengthTo(i) == length, "vertical array: wrong length to child %d", i);
+    }
+
+  return failures;
+}
+
+static int
+check_containers(const AreaRef& area)
+{
+  int failures = 0;
+  if (SmartPtr<const HorizontalArrayArea> harea = smart_cast<const HorizontalArrayArea>(area))
+    failures += check_horizontal(harea);
+  else if (SmartPtr<const VerticalArrayArea> varea = smart_cast<const VerticalArrayArea>(area))
+    failures += check_vertical(varea);
+  for (AreaIndex i = 0; i < area->size(); i++)
+    failures += check_containers(area->node(i));
+  return failures;
+}
+
+// every element must have the same box it had after the first pass
+static int
+check_boxes(const char* pass, const std::vector<ElementBox>& expected, const std::vector<ElementBox>& boxes)
+{
+  int failures = 0;
+  TEST_CHECK(failures, expected.size() == boxes.size(),
+	     "%s: %u elements formatted instead of %u", pass, unsigned(boxes.size()), unsigned(expected.size()));
+  for (unsigned i = 0; i < expected.size() && i < boxes.size(); i++)
+    TEST_CHECK(failures, expected[i].elem == boxes[i].elem && same_box(expected[i].box, boxes[i].box),
+	       "%s: element %u has a different box", pass, i);
+  return failures;
+}
+
+// a row of many terms, the base of the superscript of the last one is
+// made bold and only the elements on its path must be formatted again
+static int
+check_incremental_layout(const SmartPtr<MathView>& view)
+{
+  static const int terms = 200;
+
+  std::string buffer = "<math xmlns=\"http://www.w3.org/1998/Math/MathML\"><mrow>";
+  for (int i = 0; i < terms; i++)
+    buffer += "<mrow><mi>a</mi><mo>+</mo><msup><mi>b</mi><mn>2</mn></msup></mrow>";
+  buffer += "</mrow></math>";
+
+  int failures = 0;
+  if (!view->loadBuffer(buffer.c_str()))
+    {
+      TEST_CHECK(failures, false, "incremental layout: could not load the document");
+      return failures;
+    }
+
+  const SmartPtr<MathMLmathElement> math = smart_cast<MathMLmathElement>(view->getRootElement());
+  const SmartPtr<MathMLRowElement> row = math ? smart_cast<MathMLRowElement>(math->getChild()) : nullptr;
+  const SmartPtr<MathMLRowElement> term = row ? smart_cast<MathMLRowElement>(row->getChild(terms - 1)) : nullptr;
+  const SmartPtr<MathMLScriptElement> script = term ? smart_cast<MathMLScriptElement>(term->getChild(2)) : nullptr;
+  const SmartPtr<MathMLElement> leaf = script ? script->getBase() : nullptr;
+  if (!leaf)
+    {
+      TEST_CHECK(failures, false, "incremental layout: no superscript in the last term");
+      return failures;
+    }
+
+  view->getBoundingBox();
+  const unsigned fullCount = view->getFormattedElementCount();
+  TEST_CHECK(failures, fullCount >= unsigned(5 * terms),
+	     "incremental layout: %u elements formatted by the first pass", fullCount);
+
+  leaf->setAttribute(Attribute::create(ATTRIBUTE_SIGNATURE(MathML, Token, mathvariant), "bold"));
+  view->getBoundingBox();
+  TEST_CHECK(failures, view->getFormattedElementCount() <= leaf->getDepth(),
+	     "incremental layout: %u elements formatted for a leaf at depth %u",
+	     view->getFormattedElementCount(), leaf->getDepth());
+  return failures;
+}
+
+// radicals and bevelled fractions stretch their symbols outside the
+// shaped string caches, but the glyphs and assemblies they use are
+// cached all the same: once the tree is laid out on the heap again,
+// no area may pin the arena of an earlier pass
+static int
+check_arena_release(const SmartPtr<MathView>& view)
+{
+  static const char* buffer =
+    "<math xmlns=\"http://www.w3.org/1998/Math/MathML\"><mrow>"
+    "<msqrt><mfrac><mi>x</mi><mi>y</mi></mfrac></msqrt>"
+    "<mroot><mfrac bevelled=\"true\"><mn>1</mn><mn>2</mn></mfrac><mn>3</mn></mroot>"
+    "</mrow></math>";
+
+  int failures = 0;
+  view->setUseAreaArena(true);
+  if (!view->loadBuffer(buffer))
+    {
+      TEST_CHECK(failures, false, "radicals: could not load the document");
+      return failures;
+    }
+  view->getBoundingBox();
+  TEST_CHECK(failures, AreaArena::getStats().liveArenas == 1,
+	     "radicals: %lu arenas alive after a pass in an arena", AreaArena::getStats().liveArenas);
+
+  view->setUseAreaArena(false);
+  view->setDirtyLayout();
+  view->getBoundingBox();
+  TEST_CHECK(failures, AreaArena::getStats().liveArenas == 0,
+	     "radicals: %lu arenas alive after a pass on the heap", AreaArena::getStats().liveArenas);
+  return failures;
+}
+
+int
+main(int argc, char *argv[])
+{
+  if (argc < 2)
+    {
+      printf("usage: %s FILE [ITERATIONS]\n", argv[0]);
+      exit(1);
+    }
+
+  const int iterations = (argc > 2) ? atoi(argv[2]) : 100;
+
+  TestSetup setup;
+  if (!setup.ready())
+    {
+      printf("could not open the default font\n");
+      exit(1);
+    }
+
+  const SmartPtr<MathView>& view = setup.getView();
+  if (!view->loadURI(argv[1]))
+    {
+      printf("could not load %s\n", argv[1]);
+      exit(1);
+    }
+
+  Clock perf;
+  perf.Start();
+  for (int i = 0; i < iterations; i++)
+    {
+      view->resetRootElement();
+      view->getRootElement();
+    }
+  perf.Stop();
+  const long buildTime = perf();
+
+  // the first pass fills the shaped string caches
+  view->getBoundingBox();
+  const std::vector<ElementBox> expected = element_boxes(view);
+  int failures = check_containers(view->getRootElement()->getArea());
+
+  AreaAllocationStats heapStats[2];
+  heapStats[0] = AreaArena::getStats();
+  perf.Start();
+  for (int i = 0; i < iterations; i++)
+    {
+      view->setDirtyLayout();
+      view->getBoundingBox();
+    }
+  perf.Stop();
+  heapStats[1] = AreaArena::getStats();
+  const long formatTime = perf();
+  failures += check_boxes("heap", expected, element_boxes(view));
+
+  view->setUseAreaArena(true);
+  AreaAllocationStats arenaStats[2];
+  arenaStats[0] = AreaArena::getStats();
+  perf.Start();
+  for (int i = 0; i < iterations; i++)
+    {
+      view->setDirtyLayout();
+      view->getBoundingBox();
+    }
+  perf.Stop();
+  arenaStats[1] = AreaArena::getStats();
+  const long arenaFormatTime = perf();
+  failures += check_boxes("arena", expected, element_boxes(view));
+
+  // a new element tree parses its attribute values again, and all of
+  // them must be found in the tables (the documents in tests/ have far
+  // fewer distinct values than a table can hold)
+  const AttributeValueTable::Stats valueStatsBefore = AttributeSignature::getTotalValueTableStats();
+  view->resetRootElement();
+  view->getBoundingBox();
+  const AttributeValueTable::Stats valueStats = AttributeSignature::getTotalValueTableStats();
+  TEST_CHECK(failures, valueStats.misses == valueStatsBefore.misses,
+	     "%lu attribute values parsed again", valueStats.misses - valueStatsBefore.misses);
+  TEST_CHECK(failures, valueStats.size == valueStatsBefore.size, "the tables of attribute values grew");
+
+  failures += check_incremental_layout(view);
+  failures += check_arena_release(view);
+
+#ifdef MATHVIEW_PLAIN_REFCOUNT
+  printf("reference counting: plain\n");
+#else
+  printf("reference counting: atomic\n");
+#endif
+  printf("%d iterations, %u elements\n", iterations, unsigned(expected.size()));
+  printf("building:   %ldms (%.3fms each)\n", buildTime, double(buildTime) / iterations);
+  printf("formatting: %ldms (%.3fms each), %lu heap allocations per pass\n",
+         formatTime, double(formatTime) / iterations,
+         (heapStats[1].heap - heapStats[0].heap) / iterations);
+  printf("  in arena: %ldms (%.3fms each), %lu heap allocations per pass, %lu areas in %lu bytes per arena\n",
+         arenaFormatTime, double(arenaFormatTime) / iterations,
+         (arenaStats[1].heap - arenaStats[0].heap) / iterations,
+         (arenaStats[1].arena - arenaStats[0].arena) / iterations,
+         (arenaStats[1].arenaBytes - arenaStats[0].arenaBytes) / iterations);
+  for (const MathFontRegistry::EntryInfo& entry : MathFontRegistry::getEntries())
+    printf("math font: %u users, MATH table of %u bytes, %lu bytes in all\n",
+           entry.users, entry.tableLength, (unsigned long) entry.memoryUsage);
+  printf("attribute values: %lu parsed, %lu shared, %lu interned\n",
+         valueStats.misses, valueStats.hits, (unsigned long) valueStats.size);
+  printf("failures: %d\n", failures);
+
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,166 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+/* Compare the time taken by View::getElementAt and View::getCharAt
+ * with and without the spatial index, on a regular grid of points
+ * covering the formula, and check that both give the same answer at
+ * every point. A synthetic row whose children are raised by a step is
+ * checked first, since no document in tests/ produces one.
+ * Usage: test_hittesting FILE [POINTS] */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "Clock.hh"
+#include "AreaFactory.hh"
+#include "AreaId.hh"
+#include "SpatialIndex.hh"
+#include "Element.hh"
+#include "TestSetup.hh"
+
+typedef libxml2_MathView MathView;
+
+struct Hit
+{
+  SmartPtr<Element> elem;
+  CharIndex index;
+};
+
+static long
+hit_test(const SmartPtr<MathView>& view, const BoundingBox& box, int points, std::vector<Hit>& hits)
+{
+  hits.clear();
+  Clock perf;
+  perf.Start();
+  for (int i = 0; i < points; i++)
+    for (int j = 0; j < points; j++)
+      {
+	const scaled x = box.width.toDouble() * i / points;
+	const scaled y = -box.depth + scaled(box.verticalExtent().toDouble() * j / points);
+	Hit hit;
+	hit.elem = view->getElementAt(x, y);
+	if (!view->getCharAt(x, y, hit.index)) hit.index = -1;
+	hits.push_back(hit);
+      }
+  perf.Stop();
+  return perf();
+}
+
+static bool
+same_id(const AreaId& id1, const AreaId& id2)
+{
+  if (id1.getPath() != id2.getPath()) return false;
+  Point p1;
+  Point p2;
+  id1.getOrigin(p1);
+  id2.getOrigin(p2);
+  return p1.x == p2.x && p1.y == p2.y;
+}
+
+// a row of boxes, the second and third of which are raised by a step,
+// searched recursively and through a spatial index
+static int
+test_step(void)
+{
+  SmartPtr<AreaFactory> factory = AreaFactory::create();
+  const BoundingBox box(scaled(10), scaled(8), scaled(2));
+  std::vector<AreaRef> content;
+  content.push_back(factory->box(factory->horizontalSpace(scaled(10)), box));
+  content.push_back(factory->step(factory->box(factory->horizontalSpace(scaled(10)), box), scaled(5)));
+  content.push_back(factory->box(factory->horizontalSpace(scaled(10)), box));
+  std::vector<AreaRef> inner;
+  inner.push_back(factory->box(factory->horizontalSpace(scaled(10)), box));
+  inner.push_back(factory->step(factory->box(factory->horizontalSpace(scaled(10)), box), scaled(-7)));
+  content.push_back(factory->horizontalArray(inner));
+  const AreaRef root = factory->horizontalArray(content);
+  const SmartPtr<SpatialIndex> index = SpatialIndex::create(root);
+
+  int failures = 0;
+  for (int x = -5; x <= 55; x++)
+    for (int y = -15; y <= 20; y++)
+      {
+	AreaId linearId(root);
+	AreaId indexId(root);
+	const bool linearFound = root->searchByCoords(linearId, scaled(x), scaled(y));
+	const bool indexFound = index->searchByCoords(indexId, scaled(x), scaled(y));
+	TEST_CHECK(failures, linearFound == indexFound && (!linearFound || same_id(linearId, indexId)),
+		   "stepped row: search and index disagree at (%d, %d)", x, y);
+      }
+
+  return failures;
+}
+
+int
+main(int argc, char *argv[])
+{
+  if (argc < 2)
+    {
+      printf("usage: %s FILE [POINTS]\n", argv[0]);
+      exit(1);
+    }
+
+  const int points = (argc > 2) ? atoi(argv[2]) : 100;
+
+  int failures = test_step();
+
+  TestSetup setup;
+  if (!setup.ready())
+    {
+      printf("could not open the default font\n");
+      exit(1);
+    }
+
+  const SmartPtr<MathView>& view = setup.getView();
+  if (!view->loadURI(argv[1]))
+    {
+      printf("could not load %s\n", argv[1]);
+      exit(1);
+    }
+
+  const BoundingBox box = view->getBoundingBox();
+  std::vector<Hit> linearHits;
+  std::vector<Hit> indexHits;
+
+  view->setUseSpatialIndex(false);
+  const long linearTime = hit_test(view, box, points, linearHits);
+
+  view->setUseSpatialIndex(true);
+  Clock perf;
+  perf.Start();
+  // force the construction of the index
+  view->getElementAt(scaled::zero(), scaled::zero());
+  perf.Stop();
+  const long buildTime = perf();
+  const long indexTime = hit_test(view, box, points, indexHits);
+
+  for (unsigned i = 0; i < linearHits.size(); i++)
+    TEST_CHECK(failures, linearHits[i].elem == indexHits[i].elem && linearHits[i].index == indexHits[i].index,
+	       "point %u of the grid: search and index disagree", i);
+
+  printf("%d queries\n", 2 * points * points);
+  printf("recursive search: %ldms\n", linearTime);
+  printf("spatial index:    %ldms (+%ldms to build)\n", indexTime, buildTime);
+  printf("failures:         %d\n", failures);
+
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,326 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+/* Decode a small synthetic MATH table and check the constants, the
+ * coverage lookups, the variants and the assembly parts of its glyph
+ * constructions, then decode truncated copies of the table, whose
+ * missing parts must read as zeroes. Finally check how assemblies of
+ * synthetic constructions are laid out to cover a few spans.
+ * Usage: test_mathfont */
+
+#include <config.h>
+
+#include <stddef.h>
+#include <stdio.h>
+#include <vector>
+
+#include "MathFont.hh"
+#include "MathShaper.hh"
+#include "TestSetup.hh"
+
+// big-endian writer for the table
+class TableWriter
+{
+public:
+  void u16(unsigned offset, unsigned value)
+  {
+    if (data.size() < offset + 2) data.resize(offset + 2, 0);
+    data[offset] = (value >> 8) & 0xff;
+    data[offset + 1] = value & 0xff;
+  }
+
+  void s16(unsigned offset, int value) { u16(offset, static_cast<uint16_t>(value)); }
+
+  const std::vector<char>& getData(void) const { return data; }
+
+private:
+  std::vector<char> data;
+};
+
+static const unsigned CONSTANTS = 10;
+static const unsigned VARIANTS = CONSTANTS + sizeof(MathConstants);
+static const int AXIS_HEIGHT = -250;
+static const unsigned MIN_CONNECTOR_OVERLAP = 20;
+
+// two vertical constructions, for glyph 10 with two variants and an
+// assembly of three parts and for glyph 20 with one variant only, and
+// two horizontal ones, for glyphs 30 and 31, covered by a range. The
+// coverage comes first, so that a table cut in the middle of the
+// constructions still covers them
+static std::vector<char>
+build_table(void)
+{
+  TableWriter table;
+
+  // MathTableHeader
+  table.u16(0, 1);
+  table.u16(2, 0);
+  table.u16(4, CONSTANTS);
+  table.u16(6, 0);
+  table.u16(8, VARIANTS);
+
+  // MathConstants, laid out as in MathTable.hh
+  table.u16(CONSTANTS + offsetof(MathConstants, scriptPercentScaleDown), 80);
+  table.u16(CONSTANTS + offsetof(MathConstants, displayOperatorMinHeight), 1300);
+  table.s16(CONSTANTS + offsetof(MathConstants, axisHeight), AXIS_HEIGHT);
+  table.u16(CONSTANTS + offsetof(MathConstants, radicalKernAfterDegree), 555);
+  table.u16(CONSTANTS + offsetof(MathConstants, radicalDegreeBottomRaisePercent), 60);
+
+  // MathVariants
+  const unsigned vertCoverage = 20;
+  const unsigned horizCoverage = 28;
+  table.u16(VARIANTS, MIN_CONNECTOR_OVERLAP);
+  table.u16(VARIANTS + 2, vertCoverage);
+  table.u16(VARIANTS + 4, horizCoverage);
+  table.u16(VARIANTS + 6, 2);
+  table.u16(VARIANTS + 8, 2);
+  table.u16(VARIANTS + 10, 40);
+  table.u16(VARIANTS + 12, 90);
+  table.u16(VARIANTS + 14, 100);
+  table.u16(VARIANTS + 16, 110);
+
+  // MathGlyphConstruction of glyph 10, with its assembly 12 bytes after
+  unsigned c = VARIANTS + 40;
+  table.u16(c, 12);
+  table.u16(c + 2, 2);
+  table.u16(c + 4, 10); table.u16(c + 6, 100);
+  table.u16(c + 8, 11); table.u16(c + 10, 200);
+  const unsigned assembly = c + 12;
+  table.s16(assembly, -5);
+  table.u16(assembly + 2, 0);
+  table.u16(assembly + 4, 3);
+  const unsigned parts[3][5] = {
+    { 12, 0, 50, 300, 0 },
+    { 13, 50, 50, 100, 1 },
+    { 14, 50, 0, 300, 0 }
+  };
+  for (unsigned i = 0; i < 3; i++)
+    for (unsigned j = 0; j < 5; j++)
+      table.u16(assembly + 6 + 10 * i + 2 * j, parts[i][j]);
+
+  // glyph 20 has a variant and no assembly
+  c = VARIANTS + 90;
+  table.u16(c, 0);
+  table.u16(c + 2, 1);
+  table.u16(c + 4, 21); table.u16(c + 6, 400);
+
+  // glyphs 30 and 31 have a horizontal variant each
+  for (unsigned i = 0; i < 2; i++)
+    {
+      c = VARIANTS + 100 + 10 * i;
+      table.u16(c, 0);
+      table.u16(c + 2, 1);
+      table.u16(c + 4, 32 + i); table.u16(c + 6, 500 + 100 * i);
+    }
+
+  // vertical coverage in format 1, horizontal in format 2
+  table.u16(VARIANTS + vertCoverage, 1);
+  table.u16(VARIANTS + vertCoverage + 2, 2);
+  table.u16(VARIANTS + vertCoverage + 4, 10);
+  table.u16(VARIANTS + vertCoverage + 6, 20);
+  table.u16(VARIANTS + horizCoverage, 2);
+  table.u16(VARIANTS + horizCoverage + 2, 1);
+  table.u16(VARIANTS + horizCoverage + 4, 30);
+  table.u16(VARIANTS + horizCoverage + 6, 31);
+  table.u16(VARIANTS + horizCoverage + 8, 0);
+
+  return table.getData();
+}
+
+static SmartPtr<MathFont>
+create_font(const std::vector<char>& data, unsigned length)
+{
+  return MathFont::create(hb_blob_create(length ? &data[0] : nullptr, length,
+					 HB_MEMORY_MODE_DUPLICATE, nullptr, nullptr));
+}
+
+static int
+test_table(const std::vector<char>& data)
+{
+  int failures = 0;
+  const SmartPtr<MathFont> font = create_font(data, data.size());
+
+  TEST_CHECK(failures, font->getConstant(scriptPercentScaleDown) == 80, "scriptPercentScaleDown is %d", font->getConstant(scriptPercentScaleDown));
+  TEST_CHECK(failures, font->getConstant(displayOperatorMinHeight) == 1300, "displayOperatorMinHeight is %d", font->getConstant(displayOperatorMinHeight));
+  TEST_CHECK(failures, font->getConstant(axisHeight) == AXIS_HEIGHT, "axisHeight is %d", font->getConstant(axisHeight));
+  TEST_CHECK(failures, font->getConstant(radicalKernAfterDegree) == 555, "radicalKernAfterDegree is %d", font->getConstant(radicalKernAfterDegree));
+  TEST_CHECK(failures, font->getConstant(radicalDegreeBottomRaisePercent) == 60, "radicalDegreeBottomRaisePercent is %d", font->getConstant(radicalDegreeBottomRaisePercent));
+  TEST_CHECK(failures, font->getConstant(mathLeading) == 0, "mathLeading is %d", font->getConstant(mathLeading));
+  TEST_CHECK(failures, font->getMinConnectorOverlap() == MIN_CONNECTOR_OVERLAP, "minConnectorOverlap is %u", font->getMinConnectorOverlap());
+
+  MathFont::GlyphConstruction construction;
+  TEST_CHECK(failures, !font->getConstruction(15, false, construction), "glyph 15 has a vertical construction");
+  TEST_CHECK(failures, !font->getConstruction(10, true, construction), "glyph 10 has a horizontal construction");
+  TEST_CHECK(failures, !font->getConstruction(30, false, construction), "glyph 30 has a vertical construction");
+
+  if (font->getConstruction(10, false, construction))
+    {
+      TEST_CHECK(failures, construction.variantCount == 2, "glyph 10 has %u variants", construction.variantCount);
+      if (construction.variantCount == 2)
+	{
+	  TEST_CHECK(failures, construction.variants[0].glyph == 10 && construction.variants[0].advance == 100, "first variant of glyph 10");
+	  TEST_CHECK(failures, construction.variants[1].glyph == 11 && construction.variants[1].advance == 200, "second variant of glyph 10");
+	}
+      TEST_CHECK(failures, construction.italicsCorrection == -5, "italics correction of glyph 10 is %d", construction.italicsCorrection);
+      TEST_CHECK(failures, construction.partCount == 3, "glyph 10 has %u parts", construction.partCount);
+      if (construction.partCount == 3)
+	{
+	  const MathFont::GlyphPart* parts = construction.parts;
+	  TEST_CHECK(failures, parts[0].glyph == 12 && parts[0].startConnectorLength == 0 && parts[0].endConnectorLength == 50
+		     && parts[0].fullAdvance == 300 && !parts[0].extender, "bottom part of glyph 10");
+	  TEST_CHECK(failures, parts[1].glyph == 13 && parts[1].startConnectorLength == 50 && parts[1].endConnectorLength == 50
+		     && parts[1].fullAdvance == 100 && parts[1].extender, "extender of glyph 10");
+	  TEST_CHECK(failures, parts[2].glyph == 14 && parts[2].startConnectorLength == 50 && parts[2].endConnectorLength == 0
+		     && parts[2].fullAdvance == 300 && !parts[2].extender, "top part of glyph 10");
+	}
+    }
+  else
+    TEST_CHECK(failures, false, "glyph 10 has no vertical construction");
+
+  if (font->getConstruction(20, false, construction))
+    TEST_CHECK(failures, construction.variantCount == 1 && construction.variants[0].glyph == 21
+	       && construction.partCount == 0 && !construction.parts, "construction of glyph 20");
+  else
+    TEST_CHECK(failures, false, "glyph 20 has no vertical construction");
+
+  for (unsigned i = 0; i < 2; i++)
+    if (font->getConstruction(30 + i, true, construction))
+      TEST_CHECK(failures, construction.variantCount == 1 && construction.variants[0].glyph == 32 + i
+		 && construction.variants[0].advance == 500 + 100 * i, "construction of glyph %u", 30 + i);
+    else
+      TEST_CHECK(failures, false, "glyph %u has no horizontal construction", 30 + i);
+
+  // the first variant longer than the size, or the longest one
+  TEST_CHECK(failures, font->getVariant(10, scaled(50), false) == 10, "variant of glyph 10 for 50");
+  TEST_CHECK(failures, font->getVariant(10, scaled(150), false) == 11, "variant of glyph 10 for 150");
+  TEST_CHECK(failures, font->getVariant(10, scaled(1000), false) == 11, "variant of glyph 10 for 1000");
+  TEST_CHECK(failures, font->getVariant(31, scaled(0), true) == 33, "variant of glyph 31");
+  TEST_CHECK(failures, font->getVariant(15, scaled(1000), false) == 15, "variant of glyph 15");
+
+  return failures;
+}
+
+static int
+test_truncated(const std::vector<char>& data)
+{
+  int failures = 0;
+  MathFont::GlyphConstruction construction;
+
+  // every prefix of the table must decode without reading past its end
+  for (unsigned length = 0; length < data.size(); length++)
+    create_font(data, length)->getConstruction(10, false, construction);
+
+  // the header only: the offsets point past the end
+  const SmartPtr<MathFont> header = create_font(data, 10);
+  TEST_CHECK(failures, header->getConstant(axisHeight) == 0, "axisHeight read past the end");
+  TEST_CHECK(failures, !header->getConstruction(10, false, construction), "construction read past the end");
+
+  // the table cut in the middle of the constants
+  const unsigned cut = CONSTANTS + offsetof(MathConstants, axisHeight);
+  const SmartPtr<MathFont> constants = create_font(data, cut + 2);
+  TEST_CHECK(failures, constants->getConstant(axisHeight) == AXIS_HEIGHT, "axisHeight is %d", constants->getConstant(axisHeight));
+  TEST_CHECK(failures, constants->getConstant(radicalDegreeBottomRaisePercent) == 0, "radicalDegreeBottomRaisePercent read past the end");
+
+  // the table cut in the third part of glyph 10, after its glyph and
+  // start connector
+  const SmartPtr<MathFont> parts = create_font(data, VARIANTS + 40 + 12 + 6 + 20 + 4);
+  if (parts->getConstruction(10, false, construction) && construction.partCount == 3)
+    TEST_CHECK(failures, construction.parts[2].glyph == 14 && construction.parts[2].startConnectorLength == 50
+	       && construction.parts[2].endConnectorLength == 0 && construction.parts[2].fullAdvance == 0,
+	       "third part of glyph 10 read past the end");
+  else
+    TEST_CHECK(failures, false, "assembly of glyph 10 lost in the cut table");
+  if (parts->getConstruction(30, true, construction))
+    TEST_CHECK(failures, construction.variantCount == 0, "variants of glyph 30 read past the end");
+  else
+    TEST_CHECK(failures, false, "glyph 30 no longer covered in the cut table");
+
+  return failures;
+}
+
+static int
+check_layout(const char* name, const MathFont::GlyphConstruction& construction, int minOverlap, unsigned span,
+	     bool assembled, unsigned repeats, int overlap, int length)
+{
+  int failures = 0;
+  MathShaper::AssemblyLayout layout;
+  const bool res = MathShaper::layoutAssembly(construction, minOverlap, span, layout);
+  TEST_CHECK(failures, res == assembled, "%s for %u: %s", name, span, res ? "assembled" : "not assembled");
+  if (res && assembled)
+    TEST_CHECK(failures, layout.repeats == repeats && layout.overlap == overlap && layout.length == length,
+	       "%s for %u: %u repeats overlapping by %d, %d long instead of %u, %d, %d",
+	       name, span, layout.repeats, layout.overlap, layout.length, repeats, overlap, length);
+  return failures;
+}
+
+static int
+test_assembly(void)
+{
+  int failures = 0;
+
+  // the construction of glyph 10 in the table: two ends of 300 with
+  // connectors of 50 and an extender of 100. With a minimum overlap of
+  // 20, r repeats cover at most 580 + 80 r
+  const MathFont::GlyphVariant variants[] = { { 10, 100 }, { 11, 200 } };
+  const MathFont::GlyphPart parts[] = {
+    { 12, 0, 50, 300, false },
+    { 13, 50, 50, 100, true },
+    { 14, 50, 0, 300, false }
+  };
+  MathFont::GlyphConstruction brace = { variants, 2, parts, 3, 0 };
+
+  // the ends alone overlap by their connectors at most
+  failures += check_layout("brace", brace, 20, 500, true, 0, 100, 550);
+  failures += check_layout("brace", brace, 20, 580, true, 0, 20, 580);
+  // the excess of 40 is spread over 3 overlaps
+  failures += check_layout("brace", brace, 20, 700, true, 2, 33, 701);
+  failures += check_layout("brace", brace, 20, 2000, true, 18, 21, 2001);
+
+  // extenders no longer than the minimum overlap are never repeated
+  failures += check_layout("brace", brace, 100, 2000, true, 0, 100, 500);
+
+  // an assembly no longer than the largest variant is not used
+  const MathFont::GlyphVariant large[] = { { 10, 600 } };
+  MathFont::GlyphConstruction short_assembly = { large, 1, parts, 3, 0 };
+  failures += check_layout("short", short_assembly, 100, 2000, false, 0, 0, 0);
+  failures += check_layout("short", short_assembly, 20, 700, true, 2, 33, 701);
+
+  // a construction without parts has no assembly
+  MathFont::GlyphConstruction variants_only = { variants, 2, nullptr, 0, 0 };
+  failures += check_layout("variants", variants_only, 20, 700, false, 0, 0, 0);
+
+  // a single part does not overlap
+  const MathFont::GlyphPart bar[] = { { 15, 10, 10, 400, false } };
+  MathFont::GlyphConstruction single = { nullptr, 0, bar, 1, 0 };
+  failures += check_layout("bar", single, 20, 1000, true, 0, 0, 400);
+
+  return failures;
+}
+
+int
+main()
+{
+  const std::vector<char> data = build_table();
+  const int failures = test_table(data) + test_truncated(data) + test_assembly();
+
+  printf("failures: %d\n", failures);
+
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,87 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+/* Measure the parsing throughput of documents that are dense in
+ * MathML entity references, which the libxml2 frontend resolves
+ * itself. Usage: test_parsing [REFERENCES] [ITERATIONS] */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "Clock.hh"
+#include "Logger.hh"
+#include "libxml2_MathView.hh"
+
+typedef libxml2_MathView MathView;
+
+// entities commonly found in generated MathML
+static const char* entityNames[] = {
+  "InvisibleTimes", "ApplyFunction", "InvisibleComma", "alpha", "beta",
+  "gamma", "delta", "epsilon", "theta", "lambda", "mu", "pi", "sigma",
+  "phi", "omega", "Gamma", "Delta", "Sigma", "Omega", "int", "sum",
+  "prod", "infin", "le", "ge", "ne", "PlusMinus", "times", "rarr",
+  "part", "nabla", "ThinSpace", "af", "it", "amp", "lt",
+  NULL
+};
+
+int
+main(int argc, char *argv[])
+{
+  const int references = (argc > 1) ? atoi(argv[1]) : 10000;
+  const int iterations = (argc > 2) ? atoi(argv[2]) : 20;
+
+  std::string buffer = "<math xmlns=\"http://www.w3.org/1998/Math/MathML\"><mrow>";
+  for (int i = 0, j = 0; i < references; i++, j++)
+    {
+      if (entityNames[j] == NULL) j = 0;
+      buffer += "<mi>&";
+      buffer += entityNames[j];
+      buffer += ";</mi>";
+    }
+  buffer += "</mrow></math>";
+
+  SmartPtr<AbstractLogger> logger = Logger::create();
+  logger->setLogLevel(LOG_WARNING);
+  SmartPtr<MathView> view = MathView::create(logger);
+
+  Clock perf;
+  perf.Start();
+  for (int i = 0; i < iterations; i++)
+    if (!view->loadBuffer(buffer.c_str()))
+      {
+	printf("could not parse the document\n");
+	exit(1);
+      }
+  perf.Stop();
+
+  const long time = perf();
+  printf("%d references, %d iterations\n", references, iterations);
+  printf("parsing: %ldms (%.3fms each", time, double(time) / iterations);
+  if (time > 0)
+    printf(", %.0f references/s", 1000.0 * references * iterations / time);
+  printf(")\n");
+
+  view->resetRootElement();
+
+  return 0;
+}
@@ -100,7 +100,7 @@ int main(int argc, char *argv[]) {
 
   SmartPtr<Backend> backend = Cairo_Backend::create(cairo_font);
   SmartPtr<MathGraphicDevice> mgd = backend->getMathGraphicDevice();
-  SmartPtr<MathMLOperatorDictionary> dictionary = MathMLOperatorDictionary::create();
+  SmartPtr<MathMLOperatorDictionary> dictionary = MathMLOperatorDictionary::getDefault();
 
   view = MathView::create(logger);
   view->setOperatorDictionary(dictionary);
@@ -0,0 +1,216 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+/* Check the form inferred for the children of a few rows and the
+ * properties of an operator whose attributes are changed through the
+ * API, then measure how the time taken to format a single mrow grows with its
+ * length. The row alternates identifiers and infix operators, whose
+ * form is inferred from their position in the row, like a long
+ * polynomial. The time per term should stay about the same as the row
+ * gets longer.
+ * Usage: test_rows [TERMS] [STEPS] */
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "Clock.hh"
+#include "Attribute.hh"
+#include "MathMLAttributeSignatures.hh"
+#include "MathMLOperatorElement.hh"
+#include "MathMLmathElement.hh"
+#include "MathMLRowElement.hh"
+#include "TestSetup.hh"
+
+typedef libxml2_MathView MathView;
+
+static const char* rows[] = {
+  "<mo>-</mo><mi>x</mi><mo>+</mo><mi>y</mi><mo>!</mo>",
+  "<mspace width=\"1em\"/><mo>(</mo><mi>x</mi><mtext> </mtext><mo>)</mo><mspace width=\"1em\"/>",
+  "<mspace width=\"1em\"/><mo>+</mo>",
+  "<msub><mo>&#x2211;</mo><mi>i</mi></msub><mi>x</mi><mo>&#x2032;</mo>",
+  "<mi>a</mi><mspace width=\"1em\"/><mi>b</mi>",
+  "<mrow><mtext> </mtext></mrow><mo>=</mo><mi>a</mi><mo>=</mo><mi>b</mi>",
+  0
+};
+
+static bool
+load_row(const SmartPtr<MathView>& view, const std::string& children)
+{
+  const std::string buffer = "<math xmlns=\"http://www.w3.org/1998/Math/MathML\"><mrow>" + children + "</mrow></math>";
+  return view->loadBuffer(buffer.c_str());
+}
+
+// the form of a child as inferred before the row cached its first and
+// last non space-like children: prefix for the first of them, postfix
+// for the last, infix otherwise, and prefix for the space-like ones
+static TokenId
+position_form(const SmartPtr<MathMLRowElement>& row, unsigned i)
+{
+  unsigned rowLength = 0;
+  unsigned position = 0;
+  for (unsigned j = 0; j < row->getSize(); j++)
+    if (!row->getChild(j)->IsSpaceLike())
+      {
+	if (j == i) position = rowLength;
+	rowLength++;
+      }
+
+  if (rowLength <= 1) return T_INFIX;
+  else if (position == 0) return T_PREFIX;
+  else if (position == rowLength - 1) return T_POSTFIX;
+  else return T_INFIX;
+}
+
+static int
+test_forms(const SmartPtr<MathView>& view)
+{
+  int failures = 0;
+  for (int k = 0; rows[k]; k++)
+    {
+      if (!load_row(view, rows[k]))
+	{
+	  printf("could not parse row %d\n", k);
+	  failures++;
+	  continue;
+	}
+
+      const SmartPtr<MathMLmathElement> math = smart_cast<MathMLmathElement>(view->getRootElement());
+      const SmartPtr<MathMLRowElement> row = math ? smart_cast<MathMLRowElement>(math->getChild()) : nullptr;
+      if (!row)
+	{
+	  printf("row %d: no mrow below the math element\n", k);
+	  failures++;
+	  continue;
+	}
+
+      // the row is formatted first, so that its cached scan is used
+      view->getBoundingBox();
+      for (unsigned i = 0; i < row->getSize(); i++)
+	{
+	  const TokenId form = row->GetOperatorForm(row->getChild(i));
+	  TEST_CHECK(failures, form == position_form(row, i),
+		     "row %d, child %u: form %d instead of %d", k, i, form, position_form(row, i));
+	}
+    }
+
+  return failures;
+}
+
+// attributes changed through the API only dirty the layout of the
+// operator, which must still resolve its properties again
+static int
+test_attributes(const SmartPtr<MathView>& view)
+{
+  int failures = 0;
+  if (!load_row(view, "<mo>(</mo><mi>x</mi><mo>-</mo><mi>y</mi><mo>)</mo>"))
+    {
+      printf("could not parse the operator row\n");
+      return 1;
+    }
+
+  const SmartPtr<MathMLmathElement> math = smart_cast<MathMLmathElement>(view->getRootElement());
+  const SmartPtr<MathMLRowElement> row = math ? smart_cast<MathMLRowElement>(math->getChild()) : nullptr;
+  const SmartPtr<MathMLOperatorElement> op = row ? smart_cast<MathMLOperatorElement>(row->getChild(2)) : nullptr;
+  if (!op)
+    {
+      printf("no operator in the row\n");
+      return 1;
+    }
+
+  view->getBoundingBox();
+  const scaled lSpace = op->getLeftPadding();
+  const bool stretchy = op->IsStretchy();
+
+  op->setAttribute(Attribute::create(ATTRIBUTE_SIGNATURE(MathML, Operator, lspace), "0em"));
+  view->getBoundingBox();
+  TEST_CHECK(failures, op->getLeftPadding() == scaled::zero(), "lspace=\"0em\" not applied");
+
+  op->setAttribute(Attribute::create(ATTRIBUTE_SIGNATURE(MathML, Operator, lspace), "1em"));
+  view->getBoundingBox();
+  const scaled em = op->getLeftPadding();
+  TEST_CHECK(failures, em > scaled::zero(), "lspace=\"1em\" not applied");
+
+  op->setAttribute(Attribute::create(ATTRIBUTE_SIGNATURE(MathML, Operator, lspace), "2em"));
+  view->getBoundingBox();
+  TEST_CHECK(failures, op->getLeftPadding() == em * 2, "lspace=\"2em\" not applied");
+
+  op->removeAttribute(ATTRIBUTE_SIGNATURE(MathML, Operator, lspace));
+  view->getBoundingBox();
+  TEST_CHECK(failures, op->getLeftPadding() == lSpace, "lspace not restored after its removal");
+
+  op->setAttribute(Attribute::create(ATTRIBUTE_SIGNATURE(MathML, Operator, stretchy), stretchy ? "false" : "true"));
+  view->getBoundingBox();
+  TEST_CHECK(failures, op->IsStretchy() != stretchy, "stretchy not applied");
+
+  op->removeAttribute(ATTRIBUTE_SIGNATURE(MathML, Operator, stretchy));
+  view->getBoundingBox();
+  TEST_CHECK(failures, op->IsStretchy() == stretchy, "stretchy not restored after its removal");
+
+  return failures;
+}
+
+int
+main(int argc, char *argv[])
+{
+  const int terms = (argc > 1) ? atoi(argv[1]) : 1000;
+  const int steps = (argc > 2) ? atoi(argv[2]) : 4;
+
+  TestSetup setup;
+  if (!setup.ready())
+    {
+      printf("could not open the default font\n");
+      exit(1);
+    }
+
+  const SmartPtr<MathView>& view = setup.getView();
+  const int failures = test_forms(view) + test_attributes(view);
+
+  for (int step = 0, n = terms; step < steps; step++, n *= 2)
+    {
+      std::string buffer;
+      for (int i = 0; i < n; i++)
+	{
+	  if (i > 0) buffer += "<mo>+</mo>";
+	  buffer += "<mi>x</mi>";
+	}
+
+      if (!load_row(view, buffer))
+	{
+	  printf("could not parse the document\n");
+	  exit(1);
+	}
+      view->getRootElement();
+
+      Clock perf;
+      perf.Start();
+      view->getBoundingBox();
+      perf.Stop();
+
+      printf("%6d terms: formatting %ldms (%.2fus per term)\n",
+	     n, perf(), 1000.0 * perf() / n);
+    }
+
+  printf("failures: %d\n", failures);
+
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,183 @@
+// This file is part of GtkMathView, a flexible, high-quality rendering
+// engine for MathML documents.
+// 
+// GtkMathView is free software; you can redistribute it and/or modify it
+// either under the terms of the GNU Lesser General Public License version
+// 3 as published by the Free Software Foundation (the "LGPL") or, at your
+// option, under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation (the "GPL").  If you do not
+// alter this notice, a recipient may use your version of this file under
+// either the GPL or the LGPL.
+//
+// GtkMathView is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the LGPL or
+// the GPL for more details.
+// 
+// You should have received a copy of the LGPL and of the GPL along with
+// this program in the files COPYING-LGPL-3 and COPYING-GPL-2; if not, see
+// <http://www.gnu.org/licenses/>.
+
+/* Check that the MathShaper yields the glyphs of a full HarfBuzz
+ * shaping for every printable ASCII character and a few strings, then
+ * measure the cost of shaping the tokens of a document. Every pass
+ * clears the shaped string caches of the graphic device, so that each
+ * token goes through the MathShaper again, and is timed with the
+ * shaping cache of the MathShaper disabled (one HarfBuzz shaping per
+ * token) and enabled. Finally the font and glyph caches of the
+ * backend must stay within their limits and be emptied by clearCache.
+ * Usage: test_shaping FILE [ITERATIONS] */
+
+#include <config.h>
+
+#include <cairo-ft.h>
+#include <hb.h>
+#include <hb-ft.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "Cairo_FontCache.hh"
+#include "Clock.hh"
+#include "MathGraphicDevice.hh"
+#include "MathShaper.hh"
+#include "TestSetup.hh"
+
+typedef libxml2_MathView MathView;
+
+static void
+shape(hb_font_t* font, hb_buffer_t* buffer, const UCS4String& source, int scriptLevel, std::vector<unsigned>& glyphs)
+{
+  hb_buffer_clear_contents(buffer);
+  hb_buffer_set_direction(buffer, HB_DIRECTION_LTR);
+  hb_buffer_set_script(buffer, hb_script_from_string("Math", -1));
+  hb_buffer_add_utf32(buffer, source.c_str(), source.length(), 0, source.length());
+  const hb_feature_t ssty = { HB_TAG('s','s','t','y'), (unsigned)scriptLevel, 0, (unsigned)-1 };
+  hb_shape(font, buffer, &ssty, scriptLevel > 0 ? 1 : 0);
+
+  const unsigned len = hb_buffer_get_length(buffer);
+  const hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, nullptr);
+  glyphs.resize(len);
+  for (unsigned i = 0; i < len; i++)
+    glyphs[i] = info[i].codepoint;
+}
+
+static int
+test_glyphs(cairo_scaled_font_t* font, const SmartPtr<MathShaper>& shaper)
+{
+  FT_Face face = cairo_ft_scaled_font_lock_face(font);
+  hb_font_t* hbFont = hb_ft_font_create(face, NULL);
+  hb_buffer_t* buffer = hb_buffer_create();
+
+  std::vector<UCS4String> sources;
+  for (Char32 ch = 0x21; ch < 0x7f; ch++)
+    sources.push_back(UCS4String(1, ch));
+  static const char* strings[] = { "sin", "fi", "ff", "123", "x+y", 0 };
+  for (int i = 0; strings[i]; i++)
+    sources.push_back(UCS4StringOfString(strings[i]));
+
+  int failures = 0;
+  std::vector<unsigned> expected;
+  std::vector<unsigned> glyphs;
+  for (int scriptLevel = 0; scriptLevel <= 1; scriptLevel++)
+    for (const UCS4String& source : sources)
+      {
+	shape(hbFont, buffer, source, scriptLevel, expected);
+	shaper->shapeGlyphs(source, scriptLevel, glyphs);
+	TEST_CHECK(failures, glyphs == expected, "U+%04X... at script level %d: %u glyphs, %u expected",
+		   unsigned(source[0]), scriptLevel, unsigned(glyphs.size()), unsigned(expected.size()));
+      }
+
+  hb_buffer_destroy(buffer);
+  hb_font_destroy(hbFont);
+  cairo_ft_scaled_font_unlock_face(font);
+
+  return failures;
+}
+
+static long
+formatWithoutStringCache(const SmartPtr<MathView>& view, const SmartPtr<MathGraphicDevice>& mgd, int iterations)
+{
+  Clock perf;
+  perf.Start();
+  for (int i = 0; i < iterations; i++)
+    {
+      mgd->clearCache();
+      view->setDirtyLayout();
+      view->getBoundingBox();
+    }
+  perf.Stop();
+  return perf();
+}
+
+static int
+test_font_cache(const SmartPtr<Cairo_Backend>& backend, const SmartPtr<MathView>& view)
+{
+  int failures = 0;
+  const SmartPtr<Cairo_FontCache> cache = backend->getFontCache();
+
+  cache->setLimits(2, 16);
+  backend->clearCache();
+  view->setDirtyLayout();
+  view->getBoundingBox();
+  TEST_CHECK(failures, cache->getFontCount() <= 2, "%u fonts cached beyond the limit", unsigned(cache->getFontCount()));
+  TEST_CHECK(failures, cache->getGlyphCount() <= 16, "%u glyphs cached beyond the limit", unsigned(cache->getGlyphCount()));
+
+  backend->clearCache();
+  TEST_CHECK(failures, cache->getFontCount() == 0 && cache->getGlyphCount() == 0, "the font cache was not cleared");
+  TEST_CHECK(failures, backend->getMathGraphicDevice()->getCacheStats().entries == 0,
+	     "the shaped string caches were not cleared");
+  return failures;
+}
+
+int
+main(int argc, char *argv[])
+{
+  if (argc < 2)
+    {
+      printf("usage: %s FILE [ITERATIONS]\n", argv[0]);
+      exit(1);
+    }
+
+  const int iterations = (argc > 2) ? atoi(argv[2]) : 100;
+
+  TestSetup setup;
+  if (!setup.ready())
+    {
+      printf("could not open the default font\n");
+      exit(1);
+    }
+
+  const SmartPtr<MathGraphicDevice> mgd = setup.getBackend()->getMathGraphicDevice();
+  const SmartPtr<MathShaper> shaper = setup.getBackend()->getMathShaper();
+  int failures = test_glyphs(setup.getFont(), shaper);
+
+  const SmartPtr<MathView>& view = setup.getView();
+  if (!view->loadURI(argv[1]))
+    {
+      printf("could not load %s\n", argv[1]);
+      exit(1);
+    }
+
+  // the first pass fills the glyph caches of the backend
+  view->getBoundingBox();
+
+  shaper->setUseShapingCache(false);
+  const long uncachedTime = formatWithoutStringCache(view, mgd, iterations);
+
+  shaper->setUseShapingCache(true);
+  shaper->clearShapingCache();
+  const long cachedTime = formatWithoutStringCache(view, mgd, iterations);
+  const LRUCacheStats stats = shaper->getShapingCacheStats();
+  failures += test_font_cache(setup.getBackend(), view);
+
+  printf("%d iterations\n", iterations);
+  printf("without shaping cache: %ldms (%.3fms each)\n", uncachedTime, double(uncachedTime) / iterations);
+  printf("with shaping cache:    %ldms (%.3fms each), %lu hits, %lu misses, %lu entries in %lu bytes\n",
+         cachedTime, double(cachedTime) / iterations,
+         stats.hits, stats.misses, (unsigned long) stats.entries, (unsigned long) stats.bytes);
+  printf("failures: %d\n", failures);
+
+  return failures ? 1 : 0;
+}